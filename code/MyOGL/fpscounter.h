@@ -150,10 +150,9 @@ void EventFreqCounter<T, periodLength>::event()
 template<typename T, int periodLength>
 void EventFreqCounter<T, periodLength>::update()
 	{
-	//frequency = events / T (in s) = events * 1000.0 / periodLength (in ms)
-	freq = static_cast<int>(events * 1000.0 / periodLength);
+	//frequency = events / time (in s) = events * 1000000.0 / time (in us), time is at least periodLength
+	freq = static_cast<T>(events * 1000000.0 / curPeriodLength.restartMicroseconds());
 	events = 0;
-	curPeriodLength.shift(-periodLength);
 	fUpdated = true;
 	}
 
@@ -36,7 +36,7 @@ using namespace std;
 //---------------------------------------------------------------------------
 
 template<typename T>
-T *MyOGL::hsv2rgb<T>(T hue, T saturation, T value, T rgb[])
+T *MyOGL::hsv2rgb(T hue, T saturation, T value, T rgb[])
 	{
 	if(saturation > 0.0)
 		{
@@ -86,9 +86,12 @@ T *MyOGL::hsv2rgb<T>(T hue, T saturation, T value, T rgb[])
 	return rgb;
 	}
 
+template float *MyOGL::hsv2rgb<float>(float hue, float saturation, float value, float rgb[]);
+template double *MyOGL::hsv2rgb<double>(double hue, double saturation, double value, double rgb[]);
+
 float *MyOGL::hsv2rgb(float hue, float saturation, float value)
 	{
-	float rgb[3];
+	static float rgb[3];		//valid until the next call
 	return hsv2rgb(hue, saturation, value, rgb);
 	}
 
@@ -27,6 +27,7 @@
 
 //----------------------------------------------------------------------------
 
+#include <mmsystem.h>
 #include "scene.h"
 using namespace MyOGL;
 
@@ -38,22 +39,97 @@ void Scene::start()
 	{
 	restart_ = false;
 	done_ = false;
-	MSG msg;
+	unsimulatedTime = 0;
+	frameTimer.restart();
+	paceTimer.restart();
+	timeBeginPeriod(1);		//Sleep() in pace() would be up to 15 ms late otherwise
+	bool active = win.active();
 	do
 		{
-		if(PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+		const bool input = dispatchMessages();
+		if(done_)
+			break;
+		const bool wasActive = active;
+		active = win.active();
+		if(wasActive && !active)
+			deactivated();
+		if(!active || !(input || animating()))
 			{
-			TranslateMessage(&msg);
-			DispatchMessage(&msg);
+			WaitMessage();		//nothing to draw, don't use the processor until some message comes
+			frameTimer.restart();		//don't catch up the time when the scene was waiting
+			continue;
 			}
-		if(win.active())
+		pace();
+		advance();
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		refresh();
+		win.refresh();
+		}
+	while(!done_);
+	timeEndPeriod(1);
+	}
+
+bool Scene::dispatchMessages()
+	{
+	MSG msg;
+	bool dispatched = false;
+	while(PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+		{
+		if(msg.message == WM_QUIT)
 			{
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-			refresh();
-			win.refresh();
+			done_ = true;
+			break;
 			}
+		TranslateMessage(&msg);
+		DispatchMessage(&msg);
+		dispatched = true;
+		}
+	return dispatched;
+	}
+
+void Scene::pace()
+	{
+	if(frameRate_ > 0)
+		{
+		const boost::int64_t wait = 1000000 / frameRate_ - paceTimer.microseconds();
+		if(wait >= 1000)
+			Sleep(static_cast<DWORD>(wait / 1000));
+		}
+	paceTimer.restart();
+	}
+
+void Scene::advance()
+	{
+	const boost::int64_t tickTime = 1000000 / tickRate_;
+	unsimulatedTime += frameTimer.restartMicroseconds();
+	for(int ticks = 0; (unsimulatedTime >= tickTime) && (ticks < MAX_FRAME_TICKS); ++ticks)
+		{
+		tick(1.0f / tickRate_);
+		unsimulatedTime -= tickTime;
 		}
-	while((msg.message != WM_QUIT) && !done_);
+	if(unsimulatedTime >= tickTime)
+		unsimulatedTime %= tickTime;		//can't keep up, drop the time not simulated
+	tickAlpha_ = static_cast<float>(unsimulatedTime) / tickTime;
+	}
+
+void Scene::simulate(int ticks)
+	{
+	for(int i = 0; i < ticks; ++i)
+		tick(1.0f / tickRate_);
+	}
+
+void Scene::tickRate(int rate)
+	{
+	if(rate <= 0)
+		throw Exception("Bad scene tick rate");
+	tickRate_ = rate;
+	}
+
+void Scene::frameRate(int rate)
+	{
+	if(rate < 0)
+		throw Exception("Bad scene frame rate");
+	frameRate_ = rate;
 	}
 
 bool Scene::restart()
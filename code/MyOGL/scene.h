@@ -35,6 +35,7 @@
 //----------------------------------------------------------------------------
 
 #include "window.h"
+#include "timer.h"
 
 //----------------------------------------------------------------------------
 
@@ -98,6 +99,17 @@ namespace MyOGL
 	///All you've got to do now is write your OpenGL code in refresh(). You don't even need to bother
 	///about clearing the color and depth buffer and swapping display buffers - this is all done in
 	///Scene's start loop.
+	///@par Fixed timestep
+	///Things which should behave the same whatever the frame rate is (game simulation) can be put in
+	///tick() instead of refresh(). tick() is called tickRate() times per second of real time (so
+	///several times or not at all between two frames) and it always gets the same time step. Because
+	///the ticks and frames don't match, refresh() should draw the state interpolated between the last
+	///two ticks using tickAlpha(). Without a window, simulate() runs the ticks as fast as possible.
+	///@par Frame pacing
+	///Frames are not drawn faster than frameRate() per second, the loop sleeps between them. When
+	///the scene has nothing to animate (animating() returns false, for example a paused game) or the
+	///window is inactive, the loop waits for Windows messages and draws a frame only after some
+	///input came, so an idle scene doesn't use the processor at all.
 	class Scene
 		{
 		private:
@@ -112,7 +124,49 @@ namespace MyOGL
 			///It then can be read using same restart() method in some external enviornment.
 			///@sa restart()
 			bool restart_;
+			///Number of ticks per second.
+			///@sa tickRate()
+			int tickRate_;
+			///Real time (in us) which passed and wasn't simulated by tick() yet.
+			///@sa advance()
+			boost::int64_t unsimulatedTime;
+			///Interpolation factor between the last two ticks.
+			///@sa tickAlpha()
+			float tickAlpha_;
+			///Maximum number of frames per second, 0 means no limit.
+			///@sa frameRate()
+			int frameRate_;
+			///Measures the time between frames.
+			///@sa advance()
+			Timer frameTimer;
+			///Measures the time since the last frame was started.
+			///@sa pace()
+			Timer paceTimer;
+			///Processes all the Windows messages waiting in the queue.
+			///WM_QUIT finishes the scene just like done() does.
+			///@return True if any message was processed (so the scene should react on it).
+			bool dispatchMessages();
+			///Sleeps until the time for the next frame comes.
+			///@sa frameRate()
+			void pace();
+			///Calls tick() for all the time which passed since the previous frame.
+			///If there are more ticks to do than MAX_FRAME_TICKS, the time which can't be simulated is
+			///dropped, so that slow ticks don't slow down the frames even more (and the frames the
+			///ticks, until the game freezes).
+			///@sa start()
+			void advance();
 		protected:
+			///Default number of ticks per second.
+			///@sa tickRate()
+			static const int TICK_RATE = 120;
+			///Maximum number of ticks between two frames.
+			///With TICK_RATE it means the simulation stays real time down to 15 frames per second.
+			///@sa advance()
+			static const int MAX_FRAME_TICKS = 8;
+			///Default maximum number of frames per second.
+			///There is no use to draw more frames than ticks are done.
+			///@sa frameRate()
+			static const int FRAME_RATE = TICK_RATE;
 			///Parent window.
 			///In order to make some actions (like refreshing the window), Scene object must have an access
 			///to some window, which is called parent window.
@@ -126,7 +180,32 @@ namespace MyOGL
 			///(refresh() is called only when MyOGL::Window::active() method returns true) and swap
 			///display buffers (call MyOGL::Window::refresh()).
 			///@sa start()
+			///@sa tick()
 			virtual void refresh() = 0;
+			///Simulates a single time step.
+			///Put here everything which should be done the same number of times every second, however
+			///fast the frames are drawn. By default it does nothing.
+			///@param tau Time step in seconds (1 / tickRate()).
+			///@sa tickRate()
+			///@sa tickAlpha()
+			virtual void tick(float tau)	{}
+			///Returns the position of the current frame between the last two ticks.
+			///@return Value in range <0; 1): 0 means the frame is drawn just at the last tick, values
+			///close to 1 that the next tick is going to be done soon. Draw the state as
+			///(previous + (last - previous) * tickAlpha()).
+			float tickAlpha() const	{return tickAlpha_;}
+			///Tells whether the scene needs to be redrawn all the time.
+			///Override this method to return false when nothing on the screen moves. The scene is then
+			///drawn only when some input arrives (key press, mouse move, window activation, etc.) and
+			///the time in which the scene was waiting for it is not simulated by tick().
+			///@return True (default) if the scene should be drawn every frame.
+			virtual bool animating()	{return true;}
+			///Called when the window stops being active.
+			///The scene isn't drawn until the window is activated again, override this method to stop
+			///whatever runs on its own (for example a simulation in another thread). By default it does
+			///nothing.
+			///@sa MyOGL::Window::active()
+			virtual void deactivated()	{}
 			///Exit from the scene.
 			///Call this method in your refresh() when you want the scene to exit. The reason for that
 			///might be user action (like pressing [Esc] in example in Scene class description) or
@@ -137,15 +216,39 @@ namespace MyOGL
 		public:
 			///Constrcutor.
 			///@param parentWindow Parent Window object of a scene. See win for more details.
-			Scene(MyOGL::Window &parentWindow): restart_(false), win(parentWindow)	{}
+			Scene(MyOGL::Window &parentWindow):
+				restart_(false), tickRate_(TICK_RATE), unsimulatedTime(0), tickAlpha_(0.0),
+				frameRate_(FRAME_RATE), win(parentWindow)	{}
 			///Pure virtual destructor.
 			virtual ~Scene() = 0;
 			///Executes message loop.
 			///This method enters a loop which processes Windows BlockAnalyzerMsg, calls refresh() every frame
 			///and checks whether the done() didn't returned true (signal to finish).
+			///Before every frame tick() is called for the time passed since the previous one.
+			///See Frame pacing in the class description for when the frames are drawn.
 			///@sa refresh()
+			///@sa tick()
+			///@sa animating()
 			///@sa done()
 			virtual void start();
+			///Runs the simulation without drawing anything.
+			///Ticks are done at once, as fast as possible (for example to test the game without a window).
+			///@param ticks Number of tick() calls.
+			void simulate(int ticks);
+			///Returns the number of ticks per second.
+			///@sa tick()
+			int tickRate() const	{return tickRate_;}
+			///Changes the number of ticks per second.
+			///@param rate New rate, should be changed only before start().
+			///@throws Exception when the rate is not positive.
+			void tickRate(int rate);
+			///Returns the maximum number of frames per second.
+			///@return Frame rate limit, 0 if frames are drawn as fast as possible.
+			int frameRate() const	{return frameRate_;}
+			///Changes the maximum number of frames per second.
+			///@param rate New limit, 0 to draw frames as fast as possible.
+			///@throws Exception when the rate is negative.
+			void frameRate(int rate);
 			///Indicates wish to restart the scene or reading restart state.
 			///This function has two different behaviours depending on when and where it was called:
 			///@par 1. When scene is running
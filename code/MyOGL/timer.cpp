@@ -27,32 +27,52 @@
 
 //---------------------------------------------------------------------------
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 #include "timer.h"
 using namespace MyOGL;
-using namespace std;
 
 //---------------------------------------------------------------------------
 
-Timer::operator int() const
+boost::int64_t Timer::now()
+	{
+#ifdef _WIN32
+	static LARGE_INTEGER frequency = {0};
+	if(frequency.QuadPart == 0)
+		QueryPerformanceFrequency(&frequency);		//fixed at the system start
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	//split into seconds and the rest, so that the nanoseconds don't overflow
+	return counter.QuadPart / frequency.QuadPart * 1000000000 +
+		counter.QuadPart % frequency.QuadPart * 1000000000 / frequency.QuadPart;
+#else
+	timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return static_cast<boost::int64_t>(time.tv_sec) * 1000000000 + time.tv_nsec;
+#endif
+	}
+
+boost::int64_t Timer::microseconds() const
 	{
 	if(pauseTime == 0)
-		{
-		return ticks2ms(clock() - startTime);
-		}
+		return (now() - startTime) / 1000;
 	else
-		return ticks2ms(pauseTime - startTime);
+		return (pauseTime - startTime) / 1000;
 	}
 
-Timer &Timer::shift(int shiftTime)
+Timer &Timer::shiftMicroseconds(boost::int64_t shiftTime)
 	{
-	startTime -= ms2ticks(shiftTime);
+	startTime -= shiftTime * 1000;
 	return *this;
 	}
 
-int Timer::restart()
+boost::int64_t Timer::restartMicroseconds()
 	{
-	int lastTime = operator int();		//save the current time
-	startTime = clock();		//and reset the timer
+	const boost::int64_t lastTime = microseconds();		//save the current time
+	startTime = now();		//and reset the timer
 	pauseTime = 0;
 	return lastTime;
 	}
@@ -60,7 +80,7 @@ int Timer::restart()
 void Timer::pause()
 	{
 	if(pauseTime == 0)
-		pauseTime = clock();
+		pauseTime = now();
 	}
 
 void Timer::resume()
@@ -68,7 +88,7 @@ void Timer::resume()
 	if(pauseTime > 0)
 		{
 		//calculates the new startTime depending on the amount of time when program was paused
-		startTime = clock() - (pauseTime - startTime);
+		startTime = now() - (pauseTime - startTime);
 		pauseTime = 0;
 		}
 	}
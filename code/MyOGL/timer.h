@@ -33,7 +33,7 @@
 
 //---------------------------------------------------------------------------
 
-#include <ctime>
+#include <boost/cstdint.hpp>
 
 //---------------------------------------------------------------------------
 
@@ -42,7 +42,7 @@ namespace MyOGL
 
 //---------------------------------------------------------------------------
 
-	///Class used to store and count time in miliseconds.
+	///Class used to store and count time in miliseconds (or microseconds).
 	///@author Tomasz Nurkiewicz
 	///@date Jul 2005-Mar 2006
 	///@par Example:
@@ -83,26 +83,21 @@ namespace MyOGL
 	///
 	///And another 400000000 operations: 1313ms
 	///@endverbatim
-	///@par Liimitations
-	///Timer class uses standard library function clock() from time.h. This function may not be precise enough for some tasks.
-	///I will try to find different and portable way to calculate time in the future.
+	///@par Clock
+	///Timer measures the real (wall) time using monotonic system clock (QueryPerformanceCounter() on
+	///Windows, clock_gettime(CLOCK_MONOTONIC) elsewhere) in nanoseconds, so it doesn't depend on the
+	///processor load and it doesn't go back when the system time is changed. Time can be read in
+	///miliseconds (operator int()) or, for measuring single frames, in microseconds (microseconds()).
 	class Timer
 		{
 		private:
-			std::clock_t startTime;		///<Processor time when the timer started to count
-			///Processor time when pause() method was called.
+			boost::int64_t startTime;		///<Clock time (in ns) when the timer started to count
+			///Clock time (in ns) when pause() method was called.
 			///0 by default means that pause() wasn't called ever or resume() was called after it
-			std::clock_t pauseTime;
-			///Static method used to convert time from processor time to miliseconds
-			///@param ticks Processor time (returned by clock()) to convert
-			///@return time in miliseconds converted from time in processor time
-			///@sa ms2ticks(int ms)
-			static int ticks2ms(std::clock_t ticks)	{return static_cast<int>(static_cast<double>(ticks) / CLOCKS_PER_SEC * 1000);}
-			///Static method used to convert time from miliseconds to processor time
-			///@param ms Miliseconds to convert
-			///@return processor time converted from time in miliseconds
-			///@sa ticks2ms(std::clock_t ticks)
-			static std::clock_t ms2ticks(int ms)	{return static_cast<std::clock_t>(ms * CLOCKS_PER_SEC / 1000.0);}
+			boost::int64_t pauseTime;
+			///Returns the monotonic clock time.
+			///@return Time in nanoseconds since some unspecified moment (normally the system start).
+			static boost::int64_t now();
 		public:
 			///Constructor.
 			///Immediately after construction timer is set on
@@ -119,7 +114,12 @@ namespace MyOGL
 			///In both situations code will work properly, because object <code>tm</code> is automatically converted into int,
 			///so it can be assigned to and int variable (1) or printed by cout as na ordinary int.
 			///@return time in miliseconds which elapsed since Timer was started
-			operator int() const;
+			///@sa microseconds()
+			operator int() const	{return static_cast<int>(microseconds() / 1000);}
+			///Returns the time stored in a timer with microseconds precision.
+			///@return time in microseconds which elapsed since Timer was started
+			///@sa operator int()
+			boost::int64_t microseconds() const;
 			///Changes time relatively to current time.
 			///It gives opportunity to manually change time stored in Timer object.
 			///@par Example:
@@ -132,7 +132,11 @@ namespace MyOGL
 			///@endcode
 			///@param shiftTime time to add in miliseconds
 			///@sa pause()
-			Timer &shift(int shiftTime);
+			Timer &shift(int shiftTime)	{return shiftMicroseconds(shiftTime * static_cast<boost::int64_t>(1000));}
+			///Changes time relatively to current time with microseconds precision.
+			///@param shiftTime time to add in microseconds
+			///@sa shift()
+			Timer &shiftMicroseconds(boost::int64_t shiftTime);
 			///Restarts the timer.
 			///This method is called automatically when you create a Timer object.
 			///You can run it explicitly, if you want to reset timer and start it again.
@@ -153,7 +157,14 @@ namespace MyOGL
 			///@endcode
 			///@sa pause()
 			///@sa resume()
-			int restart();
+			///@sa restartMicroseconds()
+			int restart()	{return static_cast<int>(restartMicroseconds() / 1000);}
+			///Restarts the timer returning the time with microseconds precision.
+			///Use it to measure the time of a single frame: frames are a few miliseconds long, so
+			///rounding them to miliseconds loses a lot.
+			///@return Time in microseconds which was stored in a Timer object just before starting it again.
+			///@sa restart()
+			boost::int64_t restartMicroseconds();
 			///Pauses the timer.
 			///This method stores the time of pause() call in pauseTime.
 			///@sa pauseTime
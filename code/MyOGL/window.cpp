@@ -67,6 +67,7 @@ const bool MyOGL::FULLSCREEN = true;
 const bool MyOGL::WINDOWED = false;
 
 Window::KeyData Window::keys[256];
+KeyListener* Window::keyListener_ = 0;
 bool Window::wActive = true;
 bool Window::created = false;
 int Window::width_;
@@ -77,7 +78,7 @@ Window::MouseData Window::mouseData_;
 
 Window::Window(const std::string &iTitle, int iWidth, int iHeight, bool iFullscreen, int iExtensionsFlags):
 	extensionsFlags(iExtensionsFlags), hDC(NULL), hRC(NULL), hWnd(NULL), 
-	title(iTitle), fullscreen(iFullscreen)
+	title(iTitle), fullscreen(iFullscreen), vsync_(false)
 	{
 	if(created)
 		throw WinEx("OpenGL Window already created");
@@ -186,6 +187,7 @@ void Window::initGL()
 	glEnable(GL_DEPTH_TEST);
 	glDepthFunc(GL_LEQUAL);
 	glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
+	swapInterval();		//new rendering context doesn't remember the previous one's setting
 	}
 
 void Window::kill()
@@ -239,6 +241,14 @@ void Window::toggleFullscreen()
 	init();
 	}
 
+bool Window::swapInterval()
+	{
+	typedef BOOL (WINAPI *SwapIntervalProc)(int interval);
+	const SwapIntervalProc wglSwapIntervalEXT =
+		reinterpret_cast<SwapIntervalProc>(wglGetProcAddress("wglSwapIntervalEXT"));
+	return (wglSwapIntervalEXT != NULL) && wglSwapIntervalEXT(vsync_? 1 : 0);
+	}
+
 void Window::refresh()
 	{
 	if(extensions().enabled(FPS_COUNTER))
@@ -275,6 +285,8 @@ LRESULT CALLBACK Window::wndProc(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lPa
 			return 0;
 		case WM_KEYDOWN:
 			keys[wParam].pressed = true;
+			if(keyListener_ != 0)		//bit 30 of lParam is the previous key state
+				keyListener_->keyPressed(static_cast<int>(wParam), (lParam & 0x40000000) != 0);
 			return 0;
 		case WM_KEYUP:
 			keys[wParam].pressed = false;
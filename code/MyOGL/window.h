@@ -79,6 +79,24 @@ namespace MyOGL
 	///Used to create ordinary window by Window::Window()
 	extern const bool WINDOWED;
 
+//---------------------------------------------------------------------------
+
+	///Receives the key presses straight from the window messages.
+	///Checking keyDown() or keyPressed() once a frame misses a key which was pressed and released
+	///between two checks. A listener set with Window::keyListener() is told about every key press,
+	///in the thread which dispatches the window messages.
+	///@sa Window::keyListener()
+	class KeyListener
+		{
+		public:
+			///Called for every key press message.
+			///@param keyCode Virtual key code of the pressed key.
+			///@param repeated True if the message comes from the auto repeat of a key hold down.
+			virtual void keyPressed(int keyCode, bool repeated) = 0;
+			///Virtual destructor.
+			virtual ~KeyListener()	{}
+		};		//class KeyListener
+
 //---------------------------------------------------------------------------
 
 	///Creates window using WinAPI adapted to OpenGL programs.
@@ -192,6 +210,9 @@ namespace MyOGL
 			///If some key (for example 'A') is pressed at the moment, than key['A'] would be set to true.
 			///@sa keyDown(int keyCode)
 			static KeyData keys[256];
+			///Listener told about every key press (or 0 if none).
+			///@sa keyListener()
+			static KeyListener* keyListener_;
 			///True if program is currently active (needs to be refreshed)
 			static bool wActive;
 			///Prevents creating multiple windows (undefined behaviour).
@@ -227,6 +248,12 @@ namespace MyOGL
 			///Internal flag indicates whether we are in fullscreen or window mode.
 			///@sa toggleFullscreen()
 			bool fullscreen;
+			///Internal flag indicates whether buffer swaps should wait for the vertical retrace.
+			///@sa vsync()
+			bool vsync_;
+			///Sets the swap interval of the current rendering context according to vsync_.
+			///@return False if the graphic card driver doesn't support WGL_EXT_swap_control.
+			bool swapInterval();
 			///Copy constructor.
 			///Copy construcotr is private to prevent creating another window by copy-construction.
 			///@sa created
@@ -327,6 +354,10 @@ namespace MyOGL
 			///@sa keyDown()
 			///@sa keys
 			virtual bool keyPressed(int keyCode);
+			///Sets the listener told about every key press.
+			///@param listener New listener or 0 to remove the current one. The window doesn't own it.
+			///@sa KeyListener
+			void keyListener(KeyListener* listener)	{keyListener_ = listener;}
 			///Toggles from fullscreen to windowed mode and vice versa.
 			///Future mode depends on current window mode.
 			///Toggle means first destroying the current window (kill()) and then creating a new one (init()).
@@ -336,6 +367,17 @@ namespace MyOGL
 			///@sa init()
 			///@sa kill()
 			virtual void toggleFullscreen();
+			///Synchronizes buffer swaps with the vertical retrace of the monitor.
+			///When vsync is on, refresh() waits for the monitor to finish displaying the previous frame,
+			///so the frame rate never exceeds the monitor refresh rate. Setting is kept when the fullscreen
+			///mode is toggled.
+			///@param enable True to turn vsync on, false to swap the buffers immediately (default).
+			///@return False if the driver doesn't let to change it (then its own setting is used).
+			///@sa refresh()
+			bool vsync(bool enable)	{vsync_ = enable; return swapInterval();}
+			///Returns the vsync setting.
+			///@return True if vsync was turned on using vsync(bool).
+			bool vsync() const	{return vsync_;}
 			///Check if window is active.
 			///This information may be usefull, for example does the window needs to be refreshed.
 			///@return True if window is active, otherwise false
@@ -194,6 +194,12 @@ class XMLStream
 
 //----------------------------------------------------------------------------
 
+const int XMLStream::SYMBOL;
+const int XMLStream::IDENTIFIER;
+const int XMLStream::DATA;
+
+//----------------------------------------------------------------------------
+
 XMLStream::XMLStream(std::istream& iis): is(iis), expectData(false)
 	{
 	nextLexem();		//skip '<'
@@ -29,12 +29,10 @@
 
 #define _USE_MATH_DEFINES		///<for MS VC++ compatibility (M_* are not part of the standard)
 #include <cmath>
-#include <algorithm>
-#include <functional>
 #include <complex>
 #include "atom.h"
+#include "MyOGL/hsv2rgb.h"
 using namespace CuTe;
-using MyOGL::glColorHSV;
 
 //----------------------------------------------------------------------------
 
@@ -53,53 +51,60 @@ Atom::Electron::Electron():
 
 void Atom::Electron::update()
 	{
-	angle += timer.restart() / 1000.0 * speed;
+	angle += timer.restartMicroseconds() / 1000000.0 * speed;
 	}
 
-void Atom::Electron::draw()
+void Atom::Electron::draw(Renderer& renderer)
 	{
 	update();
-	glEnable(GL_BLEND);
-	glPushMatrix();
-	glRotatef(xEcliptic, 1.0, 0.0, 0.0);
-	glRotatef(yEcliptic, 0.0, 1.0, 0.0);
+	renderer.enable(Renderer::BLEND);
+	renderer.pushMatrix();
+	renderer.rotate(xEcliptic, 1.0, 0.0, 0.0);
+	renderer.rotate(yEcliptic, 0.0, 1.0, 0.0);
+	float rgb[3];
+	MyOGL::hsv2rgb(color, 0.2f, 1.0f, rgb);
+	Renderer::ColorVertex tail[TAIL_POINTS];
 	std::complex<float> pos = std::polar<float>(radius, angle * M_PI / 180.0);
-	glBegin(GL_LINE_STRIP);
 	for(int point = 0; point < TAIL_POINTS;
 		++point, pos *= std::polar<float>(1.0, TAIL_LENGTH / TAIL_POINTS))
 		{
-		glColorHSV(color, 0.2, 1.0, static_cast<float>(point) / TAIL_POINTS);
-		glVertex2f(pos.real(), pos.imag());
+		for(int c = 0; c < 3; ++c)
+			tail[point].color[c] = static_cast<unsigned char>(rgb[c] * 255);
+		tail[point].color[3] = static_cast<unsigned char>(255 * point / TAIL_POINTS);		//tail fades out
+		tail[point].x = pos.real();
+		tail[point].y = pos.imag();
+		tail[point].z = 0.0;
 		}
-	glEnd();
-	glPopMatrix();
-	glDisable(GL_BLEND);
+	renderer.draw(Renderer::LINE_STRIP, Renderer::C4UB_V3F, tail, TAIL_POINTS);
+	renderer.popMatrix();
+	renderer.disable(Renderer::BLEND);
 	}
 
 //----------------------------------------------------------------------------
 
 const float Atom::ROTATION_SPEED = 25.0;
 
-Atom::Atom(int iElectronsCount): rot(0.0), coreModelList(0), electronsCount(iElectronsCount)
+Atom::Atom(int iElectronsCount): rot(0.0), electronsCount(iElectronsCount)
 	{
 	electrons = new Electron[electronsCount];
 	}
 
-void Atom::draw()
+void Atom::draw(Renderer& renderer)
 	{
 	update();
-	glRotatef(rot, 0.2, 0.5, 0.8);
-	if(coreModelList > 0)		//draw model only if useModel was used
+	renderer.rotate(rot, 0.2, 0.5, 0.8);
+	if(!coreModel.empty())		//draw model only if useModel was used
 		{
-		glColorHSV(rot * M_PI / 180.0, 0.4, 1.0);
-		glCallList(coreModelList);
+		renderer.colorHSV(rot * M_PI / 180.0, 0.4, 1.0);
+		coreModel.draw(renderer);
 		}
-	std::for_each(electrons, electrons + electronsCount, std::mem_fun_ref(&Electron::draw));
+	for(int i = 0; i < electronsCount; ++i)
+		electrons[i].draw(renderer);
 	}
 
 void Atom::update()
 	{
-	rot += timer.restart() / 1000.0 * ROTATION_SPEED;
+	rot += timer.restartMicroseconds() / 1000000.0 * ROTATION_SPEED;
 	if(rot > 360.0)
 		rot -= 360.0;
 	}
@@ -125,8 +125,9 @@ namespace CuTe
 					Electron();
 					///Draws the electron.
 					///First sets up proper angles and then draws the electron including its colroed tail.
+					///@param renderer Renderer to draw with.
 					///@sa xEcliptic and yEcliptic
-					void draw();
+					void draw(Renderer& renderer);
 				};
 
 			///Whole atom ration speed.
@@ -152,10 +153,10 @@ namespace CuTe
 			///Updates the rot variable to make the whole atom rotation animation.
 			///@sa rot
 			void update();
-			///OpenGL display list containing the atom core model.
-			///This model is drawn in the center (core) of the atom. It might be any OpenGL object.
+			///Atom core model.
+			///This model is drawn in the center (core) of the atom. It might be any XML model.
 			///@sa useModel() for choosing the core object
-			GLuint coreModelList;
+			XMLModel coreModel;
 			///Number of all electrons spinning around the core.
 			///This number is given in the constructor.
 			///@sa electrons
@@ -174,13 +175,15 @@ namespace CuTe
 			///Draws the atom.
 			///First draws the atom core and then calls draw() for all electrons saved in electrons
 			///variable.
+			///@param renderer Renderer to draw with.
 			///@sa electrons
-			void draw();
+			void draw(Renderer& renderer);
 			///Specifies model to use as an atom core.
-			///This model should be coded in XML key. It is then compiled into OpenGL display list.
-			///@param coreModel XML key containing encoded model data.
-			///@sa coreModelList
-			void useModel(const MyXML::Key& coreModel)	{coreModelList = buildDisplayList(coreModel);}
+			///This model should be coded in XML key. It is then built into renderer meshes.
+			///@param renderer Renderer which keeps the model meshes.
+			///@param model XML key containing encoded model data.
+			///@sa coreModel
+			void useModel(Renderer& renderer, const MyXML::Key& model)	{coreModel.build(renderer, model);}
 		};
 
 //----------------------------------------------------------------------------
@@ -0,0 +1,346 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Microbenchmarks of the engine and analyzer hot paths.
+///
+///Every benchmark is run on the mid-game boards of the three Difficulty levels (easy 7x11, medium
+///9x15 and hard 11x19, each with its own blocks set). The boards are played by BlockAnalyzer with
+///a fixed seed, so they are the same on every run. Run it from the game directory (data/blocks.xml
+///is loaded); results are saved as JSON with:
+///@verbatim
+///cute-bench --benchmark_out=bench.json
+///@endverbatim
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include <limits>
+#include <map>
+#include <boost/shared_ptr.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <benchmark/benchmark.h>
+#include "selfplay.h"
+#include "cuboidmesh.h"
+#include "cuboidview.h"
+using namespace CuTe;
+
+//----------------------------------------------------------------------------
+
+namespace
+	{
+
+	///Seed of all the fixture games.
+	const boost::uint64_t SEED = 2006;
+
+	///Game played to the middle, exposing protected Engine methods.
+	class MidGame: public SelfPlay
+		{
+		public:
+			///Plays the game.
+			///@param difficulty Game cuboid size, depth and blocks set.
+			///@param blocks Number of blocks to put.
+			MidGame(const Difficulty& difficulty, int blocks): SelfPlay(difficulty, blocks, SEED)	{play();}
+			using Engine::distance;
+		};
+
+	///Board of a difficulty level.
+	struct Preset
+		{
+		///Difficulty data.
+		MyXML::Key diffData;
+		///Game difficulty, reads diffData.
+		Difficulty difficulty;
+		///Game played to the middle.
+		MidGame game;
+		///Plays the game on a cuboid size x size x depth with blocks set and size * size / 2 blocks.
+		Preset(int size, int depth, int blocksSet):
+			diffData(key(size, depth, blocksSet)), difficulty(diffData), game(difficulty, size * size / 2)	{}
+		///Returns the difficulty data key.
+		static MyXML::Key key(int size, int depth, int blocksSet)
+			{
+			MyXML::Key data;
+			data.attribute("size") = boost::lexical_cast<std::string>(size);
+			data.attribute("depth") = boost::lexical_cast<std::string>(depth);
+			data.attribute("blocksSet") = boost::lexical_cast<std::string>(blocksSet);
+			return data;
+			}
+		};
+
+	///Returns the board of a difficulty level, playing the game when it is used first time.
+	///@param state Benchmark state; its argument is the level (Difficulty::EASY ... HARD).
+	MidGame& game(benchmark::State& state)
+		{
+		static boost::scoped_ptr<Preset> presets[3];
+		static const int sizes[3][3] = {{7, 11, Difficulty::BLOCKS_SET_CLASSIC}, {9, 15, Difficulty::BLOCKS_SET_FLAT},
+			{11, 19, Difficulty::BLOCKS_SET_EXTREME}};
+		const int level = state.range(0);
+		if(!presets[level])
+			presets[level].reset(new Preset(sizes[level][0], sizes[level][1], sizes[level][2]));
+		state.SetLabel(boost::lexical_cast<std::string>(sizes[level][0]) + 'x' +
+			boost::lexical_cast<std::string>(sizes[level][1]));
+		return presets[level]->game;
+		}
+
+	///Fills the Z plane of a cuboid with single cubes.
+	///@param board Cuboid to fill.
+	///@param blocks All the game blocks (one of them is a single cube).
+	///@param z Z coordinate of the plane.
+	///@param random If given, every empty cell is filled with the probability 3/4 only.
+	void fillPlane(Cuboid& board, const std::vector<Block>& blocks, int z, Random* random = NULL)
+		{
+		std::vector<Block>::const_iterator cube = blocks.begin();
+		while(cube->cubes().size() != 1)
+			++cube;		//every blocks set has a single cube block
+		Block filler = *cube;
+		for(int y = 0; y < board.size(); ++y)
+			for(int x = 0; x < board.size(); ++x)
+				if(!board(x, y, z) && ((random == NULL) || ((*random)(4) != 0)))
+					{
+					filler.pos() = Point<int, 3>(x, y, z);
+					board.put(filler);
+					}
+		}
+
+	///Big board for the mesh benchmarks.
+	///Playing the game on the biggest boards takes too long, so the lower half of the cuboid is
+	///simply filled with random cubes.
+	struct RandomBoard
+		{
+		///Difficulty data.
+		MyXML::Key diffData;
+		///Game difficulty, reads diffData.
+		Difficulty difficulty;
+		///Game which is not played, its blocks fill the cuboid.
+		MidGame game;
+		///The board.
+		Cuboid cuboid;
+		///Fills a cuboid size x size x (2 * size).
+		explicit RandomBoard(int size):
+			diffData(Preset::key(size, 2 * size, Difficulty::BLOCKS_SET_CLASSIC)), difficulty(diffData),
+				game(difficulty, 0), cuboid(size, 2 * size)
+			{
+			Random random(SEED);
+			for(int z = 0; z < size; ++z)
+				fillPlane(cuboid, game.allBlocks(), z, &random);
+			}
+		};
+
+	}
+
+//----------------------------------------------------------------------------
+
+///Engine::canPut() for the current block at every (x, y, z) position.
+void BM_CanPut(benchmark::State& state)
+	{
+	MidGame& engine = game(state);
+	Block tested = engine.currentBlock();
+	while(state.KeepRunning())
+		for(int z = 0; z < engine.depth(); ++z)
+			for(int y = 0; y < engine.size(); ++y)
+				for(int x = 0; x < engine.size(); ++x)
+					{
+					tested.pos() = Point<int, 3>(x, y, z);
+					benchmark::DoNotOptimize(engine.canPut(tested));
+					}
+	state.SetItemsProcessed(state.iterations() * engine.size() * engine.size() * engine.depth());
+	}
+BENCHMARK(BM_CanPut)->DenseRange(Difficulty::EASY, Difficulty::HARD);
+
+///Block::rotateX() of every available block.
+void BM_RotateX(benchmark::State& state)
+	{
+	std::vector<Block> blocks = game(state).allBlocks();
+	while(state.KeepRunning())
+		for(std::vector<Block>::iterator b = blocks.begin(); b != blocks.end(); ++b)
+			b->rotateX(false);
+	benchmark::DoNotOptimize(blocks.front().orientation());
+	state.SetItemsProcessed(state.iterations() * blocks.size());
+	}
+BENCHMARK(BM_RotateX)->DenseRange(Difficulty::EASY, Difficulty::HARD);
+
+///Block::rotateY() of every available block.
+void BM_RotateY(benchmark::State& state)
+	{
+	std::vector<Block> blocks = game(state).allBlocks();
+	while(state.KeepRunning())
+		for(std::vector<Block>::iterator b = blocks.begin(); b != blocks.end(); ++b)
+			b->rotateY(false);
+	benchmark::DoNotOptimize(blocks.front().orientation());
+	state.SetItemsProcessed(state.iterations() * blocks.size());
+	}
+BENCHMARK(BM_RotateY)->DenseRange(Difficulty::EASY, Difficulty::HARD);
+
+///Block::rotateZ() of every available block.
+void BM_RotateZ(benchmark::State& state)
+	{
+	std::vector<Block> blocks = game(state).allBlocks();
+	while(state.KeepRunning())
+		for(std::vector<Block>::iterator b = blocks.begin(); b != blocks.end(); ++b)
+			b->rotateZ(false);
+	benchmark::DoNotOptimize(blocks.front().orientation());
+	state.SetItemsProcessed(state.iterations() * blocks.size());
+	}
+BENCHMARK(BM_RotateZ)->DenseRange(Difficulty::EASY, Difficulty::HARD);
+
+///Cuboid::removeFilledPlanes() (the work of Engine::removeFilledPlanes()) with two bottom planes
+///filled.
+///@note The time includes copying the cuboid before every removal.
+void BM_RemoveFilledPlanes(benchmark::State& state)
+	{
+	MidGame& engine = game(state);
+	Cuboid filled = engine.cuboid();
+	fillPlane(filled, engine.allBlocks(), 0);
+	fillPlane(filled, engine.allBlocks(), 1);
+	std::vector<bool> removed(engine.depth());
+	while(state.KeepRunning())
+		{
+		Cuboid board = filled;
+		benchmark::DoNotOptimize(board.removeFilledPlanes(removed));
+		}
+	}
+BENCHMARK(BM_RemoveFilledPlanes)->DenseRange(Difficulty::EASY, Difficulty::HARD);
+
+///Engine::distance() of the current block.
+void BM_Distance(benchmark::State& state)
+	{
+	MidGame& engine = game(state);
+	while(state.KeepRunning())
+		benchmark::DoNotOptimize(engine.distance());
+	}
+BENCHMARK(BM_Distance)->DenseRange(Difficulty::EASY, Difficulty::HARD);
+
+///MoveGenerator search from the current block position.
+void BM_MoveGenerator(benchmark::State& state)
+	{
+	MidGame& engine = game(state);
+	while(state.KeepRunning())
+		{
+		MoveGenerator moves(engine.cuboid(), engine.currentBlock());
+		benchmark::DoNotOptimize(moves.distance(engine.currentBlock()));
+		}
+	}
+BENCHMARK(BM_MoveGenerator)->DenseRange(Difficulty::EASY, Difficulty::HARD);
+
+///BlockAnalyzer::checkAllPositions() for all the current block orientations (see
+///BlockAnalyzer::bestFactor()), every reachable (x, y) position evaluated by countFactor().
+///The factors cache is forgotten before every iteration; the items are the placements evaluated.
+void BM_CheckAllPositions(benchmark::State& state)
+	{
+	MidGame& engine = game(state);
+	BlockAnalyzer& analyzer = engine.analyzer();
+	const MoveGenerator moves(engine.cuboid(), engine.currentBlock());
+	Block tested = engine.currentBlock();
+	int placements = 0;
+	for(int o = 0; o < tested.shape()->orientations(); ++o)
+		{
+		tested.orientation(o);
+		for(int y = 0; y < engine.size(); ++y)
+			for(int x = 0; x < engine.size(); ++x)
+				{
+				tested.pos().x() = x;
+				tested.pos().y() = y;
+				if(moves.reach(tested))
+					++placements;
+				}
+		}
+	while(state.KeepRunning())
+		{
+		state.PauseTiming();
+		analyzer.weights(analyzer.heightsWeight(), analyzer.distsWeight(), analyzer.edgesWeight());
+		state.ResumeTiming();
+		benchmark::DoNotOptimize(analyzer.bestFactor(moves, engine.currentBlock()));
+		}
+	state.SetItemsProcessed(state.iterations() * placements);
+	}
+BENCHMARK(BM_CheckAllPositions)->DenseRange(Difficulty::EASY, Difficulty::HARD);
+
+///CuboidMesh::update() building all the chunks of a RandomBoard.
+///The first argument is the board size, the second one tells whether to use greedy meshing.
+///Reports the number of triangles in the mesh.
+void BM_CuboidMesh(benchmark::State& state)
+	{
+	static std::map<int, boost::shared_ptr<RandomBoard> > boards;
+	const int size = state.range(0);
+	if(!boards[size])
+		boards[size].reset(new RandomBoard(size));
+	const Cuboid& cuboid = boards[size]->cuboid;
+	const std::vector<double> planesShift(cuboid.depth(), 0.0);
+	int faces = 0;
+	while(state.KeepRunning())
+		{
+		CuboidMesh mesh(state.range(1) != 0);
+		mesh.update(cuboid, planesShift);
+		faces = mesh.faces();
+		}
+	state.SetLabel(boost::lexical_cast<std::string>(size) + 'x' + boost::lexical_cast<std::string>(cuboid.depth()) +
+		(state.range(1)? " greedy" : " culled"));
+	state.counters["triangles"] = 2 * faces;
+	}
+BENCHMARK(BM_CuboidMesh)->Args({8, 0})->Args({8, 1})->Args({16, 0})->Args({16, 1})->Args({32, 0})->Args({32, 1});
+
+///Frame of a RandomBoard drawn by CuboidView into a RenderRecorder.
+///Arguments are the same as in BM_CuboidMesh. The meshes are created in the first frame, every
+///next one only draws them, like the game does until the next block is put on the cuboid.
+///Reports the draw calls, drawn vertices, state changes and recorded bytes of a frame.
+void BM_CuboidFrame(benchmark::State& state)
+	{
+	static std::map<int, boost::shared_ptr<RandomBoard> > boards;
+	const int size = state.range(0);
+	if(!boards[size])
+		boards[size].reset(new RandomBoard(size));
+	const Cuboid& cuboid = boards[size]->cuboid;
+	const std::vector<double> planesShift(cuboid.depth(), 0.0);
+	CuboidView view(state.range(1) != 0);
+	RenderRecorder recorder;
+	view.draw(recorder, cuboid, planesShift, 4.0 / size);
+	while(state.KeepRunning())
+		{
+		recorder.clear();
+		view.draw(recorder, cuboid, planesShift, 4.0 / size);
+		}
+	state.SetLabel(boost::lexical_cast<std::string>(size) + 'x' + boost::lexical_cast<std::string>(cuboid.depth()) +
+		(state.range(1)? " greedy" : " culled"));
+	state.counters["draws"] = recorder.draws();
+	state.counters["vertices"] = recorder.vertices();
+	state.counters["states"] = recorder.stateChanges();
+	state.counters["bytes"] = recorder.bytes();
+	view.release(recorder);
+	}
+BENCHMARK(BM_CuboidFrame)->Args({8, 0})->Args({8, 1})->Args({16, 0})->Args({16, 1})->Args({32, 0})->Args({32, 1});
+
+///MyXML::Key::loadFromFile() of data/blocks.xml.
+void BM_LoadBlocksXml(benchmark::State& state)
+	{
+	while(state.KeepRunning())
+		{
+		MyXML::Key blocksData;
+		blocksData.loadFromFile("data/blocks.xml");
+		benchmark::DoNotOptimize(blocksData.count("block"));
+		}
+	}
+BENCHMARK(BM_LoadBlocksXml);
+
+BENCHMARK_MAIN();
+
+//----------------------------------------------------------------------------
@@ -27,6 +27,11 @@
 
 //----------------------------------------------------------------------------
 
+#include <cctype>
+#include <algorithm>
+#include <fstream>
+#include <boost/bind.hpp>
+#include <boost/thread/thread.hpp>
 #include "blockanalyzer.h"
 using namespace CuTe;
 using boost::lexical_cast;
@@ -34,48 +39,111 @@ using std::string;
 
 //----------------------------------------------------------------------------
 
-const string BlockAnalyzer::BlockPos::rotCodes[] = {
-		"", "x", "XX", "X", "yZ", "y", "yz", "zzY", "zz", "YYX", "YY", "YYx",
-		"Zy", "ZYY", "ZY", "Z", "YZ", "Y", "Yz", "Yzz", "zy", "zyy", "zY", "z"};
+const string BlockAnalyzer::rotationCodes = "xxxyzzzyxxxzyyyxzzzxyyyz";
+const string BlockAnalyzer::WEIGHTS_FILE_NAME = "data/weights.xml";
 
 //----------------------------------------------------------------------------
 
-BlockAnalyzer::BlockAnalyzer(EngineExt& iParent, bool startImmediately):
-	cuboidHeights(boost::extents[iParent.size() + 2][iParent.size() + 2]), state_(IDLE), parent(iParent)
+BlockAnalyzer::BlockAnalyzer(Engine& iParent, bool startImmediately, int iThreads):
+	state_(IDLE), threads_(1), timeSlice_(ANALYSYS_MAX_TIME), lookahead_(1), lookaheadTime_(LOOKAHEAD_MAX_TIME), rollouts_(0),
+	rolloutDepth_(ROLLOUT_DEPTH), rolloutTime_(ROLLOUT_MAX_TIME), heightsWeight_(HEIGHTS_WEIGHT), distsWeight_(DISTS_WEIGHT), edgesWeight_(EDGES_WEIGHT), parent(iParent)
 	{
+	threads(iThreads);
+	loadWeights();		//use the tuned weights if there are any
 	if(startImmediately)
 		startProcess();
 	}
 
+BlockAnalyzer::FactorCache::FactorCache(): entries(1 << INDEX_BITS)
+	{
+	clear();
+	}
+
+bool BlockAnalyzer::FactorCache::find(boost::uint64_t key, int& factor)
+	{
+	const unsigned int i = index(key);
+	boost::mutex::scoped_lock lock(locks[i % LOCKS_COUNT]);
+	if(entries[i].key != key)
+		return false;
+	factor = entries[i].factor;
+	return true;
+	}
+
+void BlockAnalyzer::FactorCache::store(boost::uint64_t key, int factor)
+	{
+	const unsigned int i = index(key);
+	boost::mutex::scoped_lock lock(locks[i % LOCKS_COUNT]);
+	entries[i].key = key;
+	entries[i].factor = factor;
+	}
+
+void BlockAnalyzer::FactorCache::clear()
+	{
+	for(std::vector<Entry>::iterator entry = entries.begin(); entry != entries.end(); ++entry)
+		entry->key = 0;
+	}
+
+boost::uint64_t BlockAnalyzer::FactorCache::key(const Cuboid& board, const Block& placed)
+	{
+	boost::uint64_t placement = reinterpret_cast<std::size_t>(placed.shape());
+	placement = Cuboid::mix(placement ^ placed.orientation());
+	placement = Cuboid::mix(placement ^ static_cast<boost::uint64_t>(placed.pos().x() + 0x100));
+	placement = Cuboid::mix(placement ^ static_cast<boost::uint64_t>(placed.pos().y() + 0x100));
+	placement = Cuboid::mix(placement ^ static_cast<boost::uint64_t>(placed.pos().z() + 0x100));
+	const boost::uint64_t result = board.hash() ^ placement;
+	return (result != 0)? result : 1;		//0 marks empty entries
+	}
+
+//----------------------------------------------------------------------------
+
+void BlockAnalyzer::BlockPos::set(const Block& placed, int factor, int steps)
+	{
+	x_ = placed.pos().x();
+	y_ = placed.pos().y();
+	orientation_ = placed.orientation();
+	factor_ = factor;
+	steps_ = steps;
+	}
+
+//----------------------------------------------------------------------------
+
 void BlockAnalyzer::startProcess()
 	{
 	block = parent.currentBlock();
-	block.pos().z() = parent.depth() - 1 - 2;		//move the block forward to not collide with top wall
+	moves = MoveGenerator(parent.cuboid(), block);		//find all positions the block can get to
+	checkedOrientations.assign(block.shape()->orientations(), false);
 	best_.reset();		//reset the best block data
+	monteCarlo.candidates.clear();
 	rotation = 0;
 	state(PROCESSING);
-	countCuboidHeights();		//count heights of every (x, y) position on cuboid
 	process();		//process all possible block combinations
 	}
 
 void BlockAnalyzer::process()
 	{
-	//sequence of 24 unique block rotations
-	static const string rotationCodes = "xxxyzzzyxxxzyyyxzzzxyyyz";
 	MyOGL::Timer analysysTime;
 	do
 		{
 		switch(state())
 			{
 			case PROCESSING:
-				checkAllPositions();		//check all (x, y) block positions
-				rotateBlock(rotationCodes[rotation++]);	//rotate block after checking all available (x, y) positions
-				if(rotation >= ALL_ROTATIONS)
+				if(rollouts_ > 0)
+					checkRollouts(analysysTime);		//continue the rollouts as long as time allows
+				else if(lookahead_ > 1)
+					checkLookahead();		//check all the rotations looking ahead
+				else if(threads_ > 1)
+					checkAllRotations();		//check all the rotations at once
+				else
 					{
-					state(TRANSFORMING);		//processing done, start transforming
-					transformRot = 0;
-					transformationTimer.restart();
+					if(!checkedOrientations[block.orientation()])
+						{		//the same orientation gives the same positions, check it once
+						checkedOrientations[block.orientation()] = true;
+						checkAllPositions(parent.cuboid(), moves, block, best_);		//check all (x, y) block positions
+						}
+					rotateBlock(rotationCodes[rotation++]);	//rotate block after checking all available (x, y) positions
 					}
+				if(rotation >= ALL_ROTATIONS)
+					startTransforming();		//processing done, start transforming
 				break;
 			case TRANSFORMING:
 				transformBlock();
@@ -84,10 +152,10 @@ void BlockAnalyzer::process()
 				if(transformationTimer > MAX_TRANSFORMATION_TIME)
 					state(GAMEOVER);		//transformations take too long time, game is over
 				break;
-			case IDLE: startProcess(); break;		//processing done in previous process() call, start again
+			case IDLE: startProcess(); return;		//startProcess() used a whole time slice already
 			}
 		}
-	while(analysysTime < ANALYSYS_MAX_TIME);
+	while(analysysTime < timeSlice_);
 	}
 
 void BlockAnalyzer::state(int newState)
@@ -97,49 +165,219 @@ void BlockAnalyzer::state(int newState)
 	state_ = newState;
 	}
 
+void BlockAnalyzer::threads(int count)
+	{
+	if(count < 1)
+		throw CuTeEx("Bad analyzer threads number: " + lexical_cast<string>(count));
+	threads_ = count;
+	}
+
+void BlockAnalyzer::lookahead(int plies)
+	{
+	if(plies < 1)
+		throw CuTeEx("Bad analyzer lookahead plies number: " + lexical_cast<string>(plies));
+	lookahead_ = plies;
+	}
+
+void BlockAnalyzer::rollouts(int count)
+	{
+	if(count < 0)
+		throw CuTeEx("Bad analyzer rollouts number: " + lexical_cast<string>(count));
+	rollouts_ = count;
+	}
+
+void BlockAnalyzer::rolloutDepth(int depth)
+	{
+	if(depth < 1)
+		throw CuTeEx("Bad analyzer rollout depth: " + lexical_cast<string>(depth));
+	rolloutDepth_ = depth;
+	}
+
+void BlockAnalyzer::weights(int heights, int dists, int edges)
+	{
+	heightsWeight_ = heights;
+	distsWeight_ = dists;
+	edgesWeight_ = edges;
+	cache.clear();		//cached factors were counted with the old weights
+	}
+
+bool BlockAnalyzer::loadWeights(const std::string& fileName)
+	{
+	if(!std::ifstream(fileName.c_str()))
+		return false;		//no tuned weights at all
+	MyXML::Key weightsData(fileName);
+	MyXML::KeysConstRange range = weightsData.keys("profile");
+	for(MyXML::KeyConstIterator i = range.first; i != range.second; ++i)
+		if((lexical_cast<int>(i->second.attribute("size")) == parent.size()) &&
+			(lexical_cast<int>(i->second.attribute("blocksSet")) == parent.blocksSet()))
+			{
+			weights(lexical_cast<int>(i->second.attribute("heights")),
+				lexical_cast<int>(i->second.attribute("distances")),
+				lexical_cast<int>(i->second.attribute("edges")));
+			return true;
+			}
+	return false;
+	}
+
+void BlockAnalyzer::saveWeights(const std::string& fileName) const
+	{
+	MyXML::Key weightsData;
+	if(std::ifstream(fileName.c_str()))
+		weightsData.loadFromFile(fileName);		//keep the profiles for other games
+	else
+		weightsData.value() = "weights";
+	MyXML::Key* profile = NULL;
+	MyXML::KeysRange range = weightsData.keys("profile");
+	for(MyXML::KeyIterator i = range.first; (i != range.second) && (profile == NULL); ++i)
+		if((lexical_cast<int>(i->second.attribute("size")) == parent.size()) &&
+			(lexical_cast<int>(i->second.attribute("blocksSet")) == parent.blocksSet()))
+			profile = &i->second;
+	if(profile == NULL)
+		{
+		profile = &weightsData.insert("profile");
+		profile->attribute("size") = lexical_cast<string>(parent.size());
+		profile->attribute("blocksSet") = lexical_cast<string>(parent.blocksSet());
+		}
+	profile->attribute("heights") = lexical_cast<string>(heightsWeight_);
+	profile->attribute("distances") = lexical_cast<string>(distsWeight_);
+	profile->attribute("edges") = lexical_cast<string>(edgesWeight_);
+	weightsData.saveToFile(fileName);
+	}
+
+void BlockAnalyzer::startTransforming()
+	{
+	state(TRANSFORMING);
+	Block target = parent.currentBlock();
+	target.pos().x() = best_.x_;
+	target.pos().y() = best_.y_;
+	target.orientation(best_.orientation_);
+	best_.path_ = moves.path(target);
+	transformStep = 0;
+	transformed = parent.currentBlock();
+	transformationTimer.restart();
+	}
+
+void BlockAnalyzer::findPath()
+	{
+	Block target = parent.currentBlock();
+	target.pos().x() = best_.x_;
+	target.pos().y() = best_.y_;
+	target.orientation(best_.orientation_);
+	//if the best position is not reachable any more, the path is empty and the block stays here
+	best_.path_ = MoveGenerator(parent.cuboid(), parent.currentBlock()).path(target);
+	transformStep = 0;
+	transformed = parent.currentBlock();
+	}
+
 void BlockAnalyzer::transformBlock()
 	{
-	const std::string& curRotCodes = best_.rotations();
-	if((transformRot < curRotCodes.length()))		//there are some rotations left
-		if(rotateCurrentBlock(curRotCodes[transformRot]))		//could perform rotation?
-			++transformRot;		//prepare for next rotation
-	if(parent.currentBlock().pos().x() > best_.x())		//move block a bit to its destination
-		parent.moveLeft();
-	if(parent.currentBlock().pos().x() < best_.x())
-		parent.moveRight();
-	if(parent.currentBlock().pos().y() > best_.y())
-		parent.moveDown();
-	if(parent.currentBlock().pos().y() < best_.y())
-		parent.moveUp();
+	const Block& current = parent.currentBlock();
+	if((current.pos() != transformed.pos()) || (current.orientation() != transformed.orientation()))
+		findPath();		//block is not where it should be, find the way from its current position
+	if(transformStep < best_.path().size())
+		{
+		const MoveGenerator::Step& move = best_.path()[transformStep];
+		Block expected = transformed;
+		MoveGenerator::step(parent.cuboid(), expected, move);
+		if((move.rotation == '\0') || rotateCurrentBlock(move.rotation))
+			{		//move block a bit to its destination
+			if(move.shiftX < 0)
+				parent.moveLeft();
+			if(move.shiftX > 0)
+				parent.moveRight();
+			if(move.shiftY < 0)
+				parent.moveDown();
+			if(move.shiftY > 0)
+				parent.moveUp();
+			}
+		if((current.pos() == expected.pos()) && (current.orientation() == expected.orientation()))
+			{		//whole step done, prepare for the next one
+			transformed = expected;
+			++transformStep;
+			}
+		}
 	//update state_ to IDLE if transformation done
-	if((transformRot >= curRotCodes.length()) &&
-		(parent.currentBlock().pos().x() == best_.x()) &&
-		(parent.currentBlock().pos().y() == best_.y()))
-			state(IDLE);
+	if(transformStep >= best_.path().size())
+		state(IDLE);
 	}
 
-void BlockAnalyzer::checkAllPositions()
+void BlockAnalyzer::checkAllPositions(const Cuboid& board, const MoveGenerator& reachable, Block& tested,
+	BlockPos& found) const
 	{
-	for(int y = 0; y < parent.size(); ++y)
-		for(int x = 0; x < parent.size(); ++x)
+	for(int y = 0; y < board.size(); ++y)
+		for(int x = 0; x < board.size(); ++x)
 			{
-			block.pos().x() = x;
-			block.pos().y() = y;
-			if(parent.canPut(block))
+			tested.pos().x() = x;
+			tested.pos().y() = y;
+			if(reachable.reach(tested))		//unreachable positions are not checked at all
 				{
-				int factor = countFactor();
-				if((factor > best_.factor_) || ((factor == best_.factor_) &&
-					(BlockPos::rotationsCount(rotation) < BlockPos::rotationsCount(best_.rotation))))
-					{
-					best_.x_ = x;
-					best_.y_ = y;
-					best_.factor_ = factor;
-					best_.rotation = rotation;
-					}
+				const int factor = cachedFactor(board, tested);
+				const int steps = reachable.distance(tested);
+				if(found.worseThan(factor, steps))
+					found.set(tested, factor, steps);
 				}
 			}
 	}
 
+int BlockAnalyzer::bestFactor(const MoveGenerator& reachable, const Block& start) const
+	{
+	Block tested = start;
+	BlockPos found;
+	found.reset();
+	for(int orientation = 0; orientation < tested.shape()->orientations(); ++orientation)
+		{
+		tested.orientation(orientation);
+		checkAllPositions(parent.cuboid(), reachable, tested, found);
+		}
+	return found.factor();
+	}
+
+void BlockAnalyzer::checkAllRotations()
+	{
+	std::vector<Block> blocks;
+	for(int r = rotation; r < ALL_ROTATIONS; ++r)
+		{		//prepare block copy and result for every unchecked orientation
+		if(!checkedOrientations[block.orientation()])
+			{
+			checkedOrientations[block.orientation()] = true;
+			blocks.push_back(block);
+			}
+		rotateBlock(rotationCodes[r]);
+		}
+	std::vector<BlockPos> found(blocks.size());
+	for(std::vector<BlockPos>::iterator pos = found.begin(); pos != found.end(); ++pos)
+		pos->reset();
+	int next = 0;
+	boost::mutex nextMutex;
+	boost::thread_group workers;
+	for(int i = 1; i < threads_; ++i)
+		workers.create_thread(boost::bind(&BlockAnalyzer::checkRotations, this,
+			boost::ref(blocks), boost::ref(found), boost::ref(next), boost::ref(nextMutex)));
+	checkRotations(blocks, found, next, nextMutex);		//this thread works as well
+	workers.join_all();
+	for(std::vector<BlockPos>::const_iterator pos = found.begin(); pos != found.end(); ++pos)
+		//compare in the same order as checkAllPositions() would see them
+		if(best_.worseThan(pos->factor_, pos->steps_))
+			best_ = *pos;
+	rotation = ALL_ROTATIONS;
+	}
+
+void BlockAnalyzer::checkRotations(std::vector<Block>& blocks, std::vector<BlockPos>& found, int& next,
+	boost::mutex& nextMutex) const
+	{
+	for(;;)
+		{
+		int index;
+			{
+			boost::mutex::scoped_lock lock(nextMutex);
+			index = next++;
+			}
+		if(index >= static_cast<int>(blocks.size()))
+			return;
+		checkAllPositions(parent.cuboid(), moves, blocks[index], found[index]);
+		}
+	}
+
 void BlockAnalyzer::rotateBlock(char axis)
 	{
 	switch(toupper(axis))
@@ -165,73 +403,326 @@ bool BlockAnalyzer::rotateCurrentBlock(char axis)
 		}
 	}
 
-void BlockAnalyzer::countCuboidHeights()
+void BlockAnalyzer::checkLookahead()
 	{
-	int x;
-	for(x = 0; x < parent.size(); ++x)		//heights on a cuboid
+	Lookahead search;
+	findCandidates(search.candidates);
+	//move ordering: the best placements by factor are looked ahead first
+	std::vector<std::pair<int, int> > byFactor;
+	for(unsigned int i = 0; i < search.candidates.size(); ++i)
+		byFactor.push_back(std::make_pair(-search.candidates[i].factor, i));
+	std::sort(byFactor.begin(), byFactor.end());
+	for(unsigned int i = 0; i < byFactor.size(); ++i)
+		search.order.push_back(byFactor[i].second);
+	search.totals.resize(search.candidates.size());
+	search.expanded.resize(search.candidates.size(), false);
+	search.next = 0;
+	search.bestTotal = LOST_FACTOR * static_cast<double>(lookahead_);
+	boost::thread_group workers;
+	for(int i = 1; i < threads_; ++i)
+		workers.create_thread(boost::bind(&BlockAnalyzer::expandCandidates, this, boost::ref(search)));
+	expandCandidates(search);		//this thread works as well
+	workers.join_all();
+	double bestTotal = 0.0;
+	for(unsigned int i = 0; i < search.candidates.size(); ++i)
+		{		//compare in the same order as checkAllPositions() would see them
+		const Placement& candidate = search.candidates[i];
+		if(search.expanded[i] && ((best_.factor_ == BlockPos::MIN_FACTOR) || (search.totals[i] > bestTotal) ||
+			((search.totals[i] == bestTotal) && (candidate.steps < best_.steps_))))
+				{
+				bestTotal = search.totals[i];
+				best_.set(candidate.block, static_cast<int>(bestTotal), candidate.steps);
+				}
+		}
+	}
+
+void BlockAnalyzer::expandCandidates(Lookahead& search) const
+	{
+	const int lastPly = lookahead_ - 1;
+	int maxCubes = 0;		//the biggest block for bounding random blocks factors
+	for(std::vector<Block>::const_iterator i = parent.allBlocks().begin(); i != parent.allBlocks().end(); ++i)
+		maxCubes = std::max(maxCubes, static_cast<int>(i->cubes().size()));
+	for(;;)
+		{
+		int index;
+		double bestTotal;
+			{
+			boost::mutex::scoped_lock lock(search.mutex);
+			index = search.next++;
+			bestTotal = search.bestTotal;
+			}
+		if((index >= static_cast<int>(search.order.size())) || (index >= LOOKAHEAD_WIDTH) ||
+			((index > 0) && (search.timer > lookaheadTime_)))
+				return;
+		const Placement& candidate = search.candidates[search.order[index]];
+		const Cuboid board = placed(parent.cuboid(), candidate);
+		int lowestZ = board.depth();
+		for(int y = 0; y < board.size(); ++y)
+			for(int x = 0; x < board.size(); ++x)
+				lowestZ = std::min(lowestZ, board.height(x, y) + 1);
+		//the next block can't be put lower than lowestZ, the random ones anywhere
+		const double bound = candidate.factor + factorBound(parent.nextBlock().cubes().size(), lowestZ) +
+			(lastPly - 1) * static_cast<double>(factorBound(maxCubes, 0));
+		if(bound < bestTotal)
+			continue;		//this candidate can't be better than the best one found
+		const double total = candidate.factor + placementsValue(board, parent.nextBlock(), lastPly, search.timer);
+		boost::mutex::scoped_lock lock(search.mutex);
+		search.totals[search.order[index]] = total;
+		search.expanded[search.order[index]] = true;
+		search.bestTotal = std::max(search.bestTotal, total);
+		}
+	}
+
+void BlockAnalyzer::findCandidates(std::vector<Placement>& candidates)
+	{
+	for(; rotation < ALL_ROTATIONS; rotateBlock(rotationCodes[rotation++]))
+		{
+		if(checkedOrientations[block.orientation()])
+			continue;		//the same placements were already found
+		checkedOrientations[block.orientation()] = true;
 		for(int y = 0; y < parent.size(); ++y)
+			for(int x = 0; x < parent.size(); ++x)
+				{		//find all placements in the same order as checkAllPositions()
+				block.pos().x() = x;
+				block.pos().y() = y;
+				if(moves.reach(block))
+					{
+					Placement candidate = {block, moves.distance(block), cachedFactor(parent.cuboid(), block)};
+					candidates.push_back(candidate);
+					}
+				}
+		}
+	}
+
+void BlockAnalyzer::checkRollouts(const MyOGL::Timer& analysysTime)
+	{
+	if(monteCarlo.candidates.empty())
+		{		//the search starts
+		findCandidates(monteCarlo.candidates);
+		if(monteCarlo.candidates.empty())
+			return;		//nowhere to put the block, rotation is ALL_ROTATIONS already
+		std::stable_sort(monteCarlo.candidates.begin(), monteCarlo.candidates.end(), betterFactor);
+		if(monteCarlo.candidates.size() > LOOKAHEAD_WIDTH)
+			monteCarlo.candidates.resize(LOOKAHEAD_WIDTH);
+		monteCarlo.sums.assign(monteCarlo.candidates.size(), 0.0);
+		monteCarlo.counts.assign(monteCarlo.candidates.size(), 0);
+		monteCarlo.next = 0;
+		//the same game and position always get the same rollouts
+		monteCarlo.seed = Cuboid::mix(parent.seed() ^ parent.cuboid().hash());
+		monteCarlo.timer.restart();
+		rotation = 0;		//not done until the rollouts are
+		}
+	boost::thread_group workers;
+	for(int i = 1; i < threads_; ++i)
+		workers.create_thread(boost::bind(&BlockAnalyzer::runRollouts, this, boost::cref(analysysTime)));
+	runRollouts(analysysTime);		//this thread works as well
+	workers.join_all();
+	if(!rolloutsDone())
+		return;		//continue in the next call
+	double bestValue = 0.0;
+	for(unsigned int i = 0; i < monteCarlo.candidates.size(); ++i)
+		{		//the better factor wins if the values are equal
+		const double value = monteCarlo.sums[i] / monteCarlo.counts[i];
+		if((i == 0) || (value > bestValue))
 			{
-			int z;
-			for(z = parent.depth() - 1; z >= 0; --z)	{
-				if(parent(x, y, z))
-					break;	}
-			cuboidHeights[1 + x][1 + y] = z;
+			bestValue = value;
+			best_.set(monteCarlo.candidates[i].block, static_cast<int>(value), monteCarlo.candidates[i].steps);
 			}
-	for(int p = 1; p <= parent.size(); ++p)		//set height borders
+		}
+	rotation = ALL_ROTATIONS;
+	}
+
+void BlockAnalyzer::runRollouts(const MyOGL::Timer& analysysTime)
+	{
+	const int width = monteCarlo.candidates.size();
+	for(;;)
 		{
-		cuboidHeights[p][0] = cuboidHeights[p][1] + 1;
-		cuboidHeights[p][parent.size() + 1] = cuboidHeights[x][parent.size()] + 1;
-		cuboidHeights[0][p] = cuboidHeights[1][p] + 1;
-		cuboidHeights[parent.size() + 1][p] = cuboidHeights[parent.size()][p] + 1;
+		int index;
+			{
+			boost::mutex::scoped_lock lock(monteCarlo.mutex);
+			if(rolloutsDone() || (analysysTime > timeSlice_))
+				return;
+			index = monteCarlo.next++;
+			}
+		Random random(monteCarlo.seed + index / width);		//every round has its own blocks
+		const double value = rollout(monteCarlo.candidates[index % width], random);
+		boost::mutex::scoped_lock lock(monteCarlo.mutex);
+		monteCarlo.sums[index % width] += value;
+		++monteCarlo.counts[index % width];
 		}
 	}
 
-int BlockAnalyzer::distance() const
+bool BlockAnalyzer::rolloutsDone() const
 	{
-	int dist = parent.depth();
-	for(int x = -block.range(); x <= block.range(); ++x)
-		for(int y = -block.range(); y <= block.range(); ++y)
-			for(int z = -block.range(); z <= block.range(); ++z)
-				if(block(x, y, z))
+	const int width = monteCarlo.candidates.size();
+	return (monteCarlo.next >= width * rollouts_) || ((monteCarlo.next >= width) && (monteCarlo.timer > rolloutTime_));
+	}
+
+double BlockAnalyzer::rollout(const Placement& candidate, Random& random) const
+	{
+	const std::vector<Block>& blocks = parent.allBlocks();
+	Cuboid board = parent.cuboid();
+	std::vector<bool> removed(board.depth());
+	Block tested = candidate.block;
+	double value = candidate.factor;
+	for(int put = 0; ; ++put)
+		{
+		tested.pos().z() -= board.dropDistance(tested);
+		board.put(tested);
+		board.removeFilledPlanes(removed);
+		if(put == rolloutDepth_)
+			return value;
+		tested = (put == 0)? parent.nextBlock() : blocks[random(blocks.size())];
+		int factor;
+		if(!greedyPlacement(board, tested, factor))		//game lost, the sooner the worse
+			return value + LOST_FACTOR * static_cast<double>(rolloutDepth_ - put) / rolloutDepth_;
+		value += factor;
+		}
+	}
+
+bool BlockAnalyzer::greedyPlacement(const Cuboid& board, Block& tested, int& factor) const
+	{
+	//every orientation fits below the top wall there (see MoveGenerator)
+	tested.pos().z() = std::min(tested.pos().z(), board.depth() - 1 - tested.range());
+	Block best;
+	for(int orientation = 0; orientation < tested.shape()->orientations(); ++orientation)
+		{
+		tested.orientation(orientation);
+		for(int y = 0; y < board.size(); ++y)
+			for(int x = 0; x < board.size(); ++x)
+				{
+				tested.pos().x() = x;
+				tested.pos().y() = y;
+				if(!board.canPut(tested))
+					continue;
+				const int testedFactor = cachedFactor(board, tested);
+				if((best.shape() == NULL) || (testedFactor > factor))
+					{
+					best = tested;
+					factor = testedFactor;
+					}
+				}
+		}
+	if(best.shape() == NULL)
+		return false;
+	tested = best;
+	return true;
+	}
+
+void BlockAnalyzer::findPlacements(const Cuboid& board, Block& tested, std::vector<Placement>& found) const
+	{
+	if(!board.enter(tested))
+		return;		//block doesn't even enter the cuboid
+	//only reachability matters here, so the faster single steps are enough
+	const MoveGenerator reachable(board, tested, false);
+	for(int orientation = 0; orientation < tested.shape()->orientations(); ++orientation)
+		{
+		tested.orientation(orientation);
+		for(int y = 0; y < board.size(); ++y)
+			for(int x = 0; x < board.size(); ++x)
+				{
+				tested.pos().x() = x;
+				tested.pos().y() = y;
+				if(reachable.reach(tested))
 					{
-					int curDist =
-						block.pos().z() + z - cuboidHeights[1 + block.pos().x() + x][1 + block.pos().y() + y] - 1;
-					if(curDist < dist)
-						dist = curDist;
-					break;
+					Placement placement = {tested, reachable.distance(tested), cachedFactor(board, tested)};
+					found.push_back(placement);
 					}
-	return dist;
+				}
+		}
+	}
+
+Cuboid BlockAnalyzer::placed(const Cuboid& board, const Placement& placement)
+	{
+	Cuboid result = board;
+	Block dropped = placement.block;
+	dropped.pos().z() -= board.dropDistance(dropped);
+	result.put(dropped);
+	std::vector<bool> removed(board.depth());
+	result.removeFilledPlanes(removed);
+	return result;
+	}
+
+double BlockAnalyzer::placementsValue(const Cuboid& board, const Block& placedBlock, int plies,
+	const MyOGL::Timer& timer) const
+	{
+	std::vector<Placement> found;
+	Block tested = placedBlock;
+	findPlacements(board, tested, found);
+	if(found.empty())
+		return LOST_FACTOR * static_cast<double>(plies);
+	std::stable_sort(found.begin(), found.end(), betterFactor);
+	if(plies == 1)
+		return found.front().factor;
+	double best = LOST_FACTOR * static_cast<double>(plies);
+	for(unsigned int i = 0; (i < found.size()) && (i < LOOKAHEAD_WIDTH); ++i)
+		{
+		if((i > 0) && (timer > lookaheadTime_))
+			break;		//no more time, at least the best placement was looked ahead
+		best = std::max(best, found[i].factor + expectedValue(placed(board, found[i]), plies - 1, timer));
+		}
+	return best;
+	}
+
+double BlockAnalyzer::expectedValue(const Cuboid& board, int plies, const MyOGL::Timer& timer) const
+	{
+	const std::vector<Block>& blocks = parent.allBlocks();
+	double sum = 0.0;
+	for(std::vector<Block>::const_iterator i = blocks.begin(); i != blocks.end(); ++i)
+		sum += placementsValue(board, *i, plies, timer);
+	return sum / blocks.size();
+	}
+
+int BlockAnalyzer::factorBound(int cubes, int lowestZ) const
+	{
+	//every cube has at most 4 neighbours and one empty field under it
+	const int edges = (edgesWeight_ > 0)? edgesWeight_ * 4 : 0;
+	const int dists = (distsWeight_ > 0)? distsWeight_ : 0;
+	const int heights = heightsWeight_ * ((heightsWeight_ < 0)? lowestZ : parent.depth() - 1);
+	return cubes * (edges + dists + heights);
+	}
+
+int BlockAnalyzer::cachedFactor(const Cuboid& board, Block& tested) const
+	{
+	const boost::uint64_t key = FactorCache::key(board, tested);
+	int factor;
+	if(!cache.find(key, factor))
+		{
+		factor = countFactor(board, tested);
+		cache.store(key, factor);
+		}
+	return factor;
 	}
 
-int BlockAnalyzer::countFactor()
+int BlockAnalyzer::countFactor(const Cuboid& board, Block& tested) const
 	{
-	int dist = distance();
-	block.pos().z() -= dist;		//move block forwars as far as possible
+	const int dist = board.dropDistance(tested);
+	tested.pos().z() -= dist;		//move block forwars as far as possible
 	int heightsFactor = 0;
 	int distsFactor = 0;
 	int edgeFactor = 0;
-	for(int x = -block.range(); x <= block.range(); ++x)
-		for(int y = -block.range(); y <= block.range(); ++y)
-			for(int z = -block.range(); z <= block.range(); ++z)
-				if(block(x, y, z))
+	for(int x = -tested.range(); x <= tested.range(); ++x)
+		for(int y = -tested.range(); y <= tested.range(); ++y)
+			for(int z = -tested.range(); z <= tested.range(); ++z)
+				if(tested(x, y, z))
 					{
-					heightsFactor += block.pos().z() + z;
-					const int baseX = block.pos().x() + x;
-					const int baseY = block.pos().y() + y;
-					const int baseZ = block.pos().z() + z;
-					if(parent(baseX - 1, baseY, baseZ))
+					heightsFactor += tested.pos().z() + z;
+					const int baseX = tested.pos().x() + x;
+					const int baseY = tested.pos().y() + y;
+					const int baseZ = tested.pos().z() + z;
+					if(board(baseX - 1, baseY, baseZ))
 						++edgeFactor;
-					if(parent(baseX + 1, baseY, baseZ))
+					if(board(baseX + 1, baseY, baseZ))
 						++edgeFactor;
-					if(parent(baseX, baseY - 1, baseZ))
+					if(board(baseX, baseY - 1, baseZ))
 						++edgeFactor;
-					if(parent(baseX, baseY + 1, baseZ))
+					if(board(baseX, baseY + 1, baseZ))
 						++edgeFactor;
-					if((((z > -2) && !block(x, y, z - 1)) || (z == -2)) && !parent(baseX, baseY, baseZ - 1))
+					if((((z > -2) && !tested(x, y, z - 1)) || (z == -2)) && !board(baseX, baseY, baseZ - 1))
 						++distsFactor;
 					}
-	block.pos().z() += dist;
-	return heightsFactor * HEIGHTS_WEIGHT + distsFactor * DISTS_WEIGHT + edgeFactor * EDGES_WEIGHT;
+	tested.pos().z() += dist;
+	return heightsFactor * heightsWeight_ + distsFactor * distsWeight_ + edgeFactor * edgesWeight_;
 	}
 
 //----------------------------------------------------------------------------
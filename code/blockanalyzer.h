@@ -32,8 +32,10 @@
 
 //----------------------------------------------------------------------------
 
-#include <boost/multi_array.hpp>
-#include "glengine.h"
+#include <vector>
+#include <boost/thread/mutex.hpp>
+#include "MyOGL/timer.h"
+#include "movegenerator.h"
 
 //----------------------------------------------------------------------------
 
@@ -52,12 +54,12 @@ namespace CuTe
 	class BlockAnalyzer
 		{
 		private:
-			///Heights factor weight.
+			///Default heights factor weight.
 			///Heights factor describes how high the block is counting from the bottom
 			///of the cuboid. The lower it is the better - that's why the factor is negative.
 			///@sa countFactor()
 			static const int HEIGHTS_WEIGHT = -8;
-			///Distances factor weight.
+			///Default distances factor weight.
 			///The distances factor describes the sum of distances between the cubes in a current block
 			///and the topmost cubes on a cuboid lying beneath them. Ideally this factor is zero
 			///which mean all the cubes fits ideally (there are no "wholes" which are hidden by block
@@ -66,7 +68,7 @@ namespace CuTe
 			///That's because this factor is so big.
 			///@sa countFactor()
 			static const int DISTS_WEIGHT = -256;
-			///Edges fit factor weight.
+			///Default edges fit factor weight.
 			///Edges fit factor describes how does the block fit to the cubes already existing on a cuboid.
 			///The engine should always choose those positions on which the block adhere to other blocks
 			///as much as possible.
@@ -79,7 +81,7 @@ namespace CuTe
 			///@sa rotation
 			///@sa checkAllPositions
 			static const int ALL_ROTATIONS = 24;
-			///Maximum time (in ms) for the process() function to run.
+			///Default maximum time (in ms) for the process() function to run (see timeSlice()).
 			///It takes some time to test all the possible block positions on the cuboid. If tjhe process()
 			///function could run as long as it could, it would cause the whole game (including display
 			///sub system) to freeze for a moment (this could be even a few seconds depending on a
@@ -93,14 +95,34 @@ namespace CuTe
 			///@sa process()
 			static const int ANALYSYS_MAX_TIME = 15;
 			///Maximum time (in ms) for the block transformations.
-			///Sometimes it happens that the analyzer finds the best position but it can't transform
-			///the block any how to this position. There is not elegant way to detect such a clash
-			///so I've choosen to test the transformation time. If the transformation takes to much time
+			///Only reachable positions are chosen (see MoveGenerator) and the way is looked for again
+			///if the block moves unexpectedly, but if the transformation still takes to much time
 			///it means that the game is stucked and should be restarted
 			///@sa process() where this time is checked
 			///@sa GAMEOVER state
 			///@sa transformationTimer
 			static const int MAX_TRANSFORMATION_TIME = 1000;
+			///Sequence of rotations visiting all 24 block rotations.
+			///Rotating the block by rotationCodes[n] moves it from rotation n to rotation n + 1.
+			///@sa rotateBlock()
+			static const std::string rotationCodes;
+			///Number of the best placements (by countFactor()) looked ahead on every ply.
+			///Other placements are not followed by the next blocks at all.
+			///@sa lookahead()
+			static const int LOOKAHEAD_WIDTH = 12;
+			///Default time (in ms) for a single lookahead decision.
+			///@sa lookaheadTime()
+			static const int LOOKAHEAD_MAX_TIME = 200;
+			///Factor of a position in which the block can't be put anywhere.
+			///It is so small that any other position is better than the lost one.
+			static const int LOST_FACTOR = -1000000;
+			///Default number of blocks put in a single rollout after the candidate placement.
+			///Longer rollouts add more noise than information with the random blocks.
+			///@sa rolloutDepth()
+			static const int ROLLOUT_DEPTH = 2;
+			///Default time (in ms) for a single rollouts decision.
+			///@sa rolloutTime()
+			static const int ROLLOUT_MAX_TIME = 200;
 
 			///Stores the neccessery information while computing and transforming block position.
 			///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
@@ -111,21 +133,6 @@ namespace CuTe
 			class BlockPos
 				{
 				private:
-					///Array of rotation codes for all specific rotations.
-					///There are 24 unique block rotations. The analyzer tests them one after another and if it
-					///finds the one particular rotation to fit more than others, it saves its number. But
-					///the problem arises: how to rotate the block from its starting position to the one
-					///got in the rotation. Of course the transforming module could perform n rotations if
-					///the analyzer found the nth rotation be the best. But this means that in some cases
-					///the block would rotate even more than 20 times on user eyes - this would look
-					///silly and take (redundantly) too much time.<br>
-					///This array solves the problem: it appers that to get to the specific rotation from
-					///the starting position we need not more than 3 rotations! This 24 array elements saves
-					///those rotations and are used as a look-up table.
-					///@sa rotations()
-					///@sa rotationsCount()
-					///@sa rotation
-					static const std::string rotCodes[ALL_ROTATIONS];
 					///Minimum block position factor.
 					///At the beginning it is set to some minimum value so any block position found as first
 					///(even the worst) would be saved.
@@ -143,35 +150,43 @@ namespace CuTe
 					///Block position Y coordinate.
 					///Stores the Y coordinate of a block in a cuboid.
 					int y_;
-					///Block rotation number.
-					///Stores the rotation number (index) at which the block should be set. To get the sequence
-					///of rotations to be performed to set the block in this rotation, use rotations() method.
-					///@sa rotations()
-					int rotation;
+					///Block orientation index.
+					///@sa Block::orientation()
+					int orientation_;
+					///Number of transformation steps needed to reach the position.
+					///@sa MoveGenerator::distance()
+					int steps_;
+					///Transformation steps leading to the position.
+					///Found only when processing is done.
+					///@sa path()
+					MoveGenerator::Path path_;
 					///Resets the block position.
 					///Resets some fields of block position object when the object is being used again in next
 					///analysis process.
-					void reset()	{factor_ = MIN_FACTOR;}
-					///Number of rotations to performs at specified rotation number.
-					///This function is used when two block positions have the same factor: algorithm
-					///chooses the one which envolves less rotation operations.
-					///@param rotation Rotation index to check.
-					///@return Number of rotations to perform to set the block at the position coded
-					///at the given rotation. This means how many times the block must be rotated to set
-					///him at the given rotation position.
-					///@sa rotCodes
-					///@sa rotations()
-					static int rotationsCount(int rotation)	{return rotCodes[rotation].length();}
+					void reset()	{factor_ = MIN_FACTOR; steps_ = 0; path_.clear();}
+					///Checks whether another position is better than this one.
+					///When two block positions have the same factor, algorithm chooses the one which needs
+					///less transformation steps.
+					///@param factor Fit factor of another position.
+					///@param steps Number of steps needed to reach another position.
+					///@return True if another position is better.
+					bool worseThan(int factor, int steps) const
+						{return (factor > factor_) || ((factor == factor_) && (steps < steps_));}
+					///Saves the position of a block.
+					///@param placed Block at its position and orientation.
+					///@param factor Fit factor of the position.
+					///@param steps Number of steps needed to reach the position.
+					void set(const Block& placed, int factor, int steps);
 				public:
 					///BlockAnalyzer has full access to BlockPos fields.
 					///Functions x(), y() and factor() have only informing job - the BlockAnalyzer can
 					///access all the private parts of this class as he wish.
 					friend class BlockAnalyzer;
-					///Returns the sequence of rotations to performs.
-					///@return String containing the sequence of rotations to be performed to set the block
-					///at the desired rotation position.
-					///@sa rotCodes for more details
-					const std::string& rotations() const	{return rotCodes[rotation];}
+					///Returns the sequence of transformations to perform.
+					///@return Steps to be performed to set the block at the desired position, available
+					///when the processing is done.
+					///@sa MoveGenerator::path()
+					const MoveGenerator::Path& path() const	{return path_;}
 					///Returns the block X coordinate.
 					///This function might be used by the environment to output the best block position
 					///coordinates. Because the BlockAnalyzer has access to private parts of BlockPos, it does
@@ -192,6 +207,113 @@ namespace CuTe
 					int factor() const	{return factor_;}
 				};		//class BlockPos
 
+			///Block placement considered during lookahead.
+			struct Placement
+				{
+				///Block at its (x, y) position, not moved forward yet.
+				Block block;
+				///Number of transformation steps needed to reach the placement.
+				int steps;
+				///Fit factor of the placement as returned by countFactor().
+				int factor;
+				};
+			///Compares placements by their factors, used for sorting the best placements first.
+			///@return True if left placement has greater factor than right one.
+			static bool betterFactor(const Placement& left, const Placement& right)	{return left.factor > right.factor;}
+			///Shared state of a lookahead search.
+			///@sa checkLookahead()
+			struct Lookahead
+				{
+				///All the current block placements in the order checkAllPositions() would find them.
+				std::vector<Placement> candidates;
+				///Indexes of candidates, sorted by their factor (the best first).
+				std::vector<int> order;
+				///Lookahead values of the candidates (factor of the candidate and the following ones).
+				std::vector<double> totals;
+				///Which candidates have their totals counted.
+				///@note vector<char>, not vector<bool>, because the elements are written by many threads.
+				std::vector<char> expanded;
+				///Index in order of the next candidate to expand.
+				int next;
+				///Best total found so far.
+				double bestTotal;
+				///Mutex guarding next, totals, expanded and bestTotal.
+				boost::mutex mutex;
+				///Time elapsed since the search started.
+				MyOGL::Timer timer;
+				};
+			///Shared state of a rollouts search.
+			///The search goes on through many process() calls, so it is kept in the analyzer.
+			///@sa checkRollouts()
+			struct MonteCarlo
+				{
+				///The best current block placements by factor (the best first), at most LOOKAHEAD_WIDTH.
+				std::vector<Placement> candidates;
+				///Sum of the rollout values of every candidate.
+				std::vector<double> sums;
+				///Number of rollouts done from every candidate.
+				std::vector<int> counts;
+				///Index of the next rollout to do.
+				///Rollouts are done in rounds, one for every candidate: rollout n is round
+				///n / candidates.size() of candidate n % candidates.size().
+				int next;
+				///Seed of the random blocks; every round uses the same blocks for all the candidates.
+				boost::uint64_t seed;
+				///Mutex guarding next, sums and counts.
+				boost::mutex mutex;
+				///Time elapsed since the search started.
+				MyOGL::Timer timer;
+				};
+			///Cache of placements evaluated so far.
+			///@par
+			///Every placement is identified by the Zobrist hash of the cuboid (Cuboid::hash()) mixed with
+			///the block shape, orientation and position, so a placement evaluated once is never
+			///evaluated again - neither for another block nor in another lookahead ply.
+			///Colliding keys (which are extremely rare for 64-bit keys) simply give the wrong factor.
+			///@par
+			///The cache is a fixed size table where a new entry replaces the old one with the same index.
+			///It is shared by all the worker threads, every part of the table has its own mutex.
+			class FactorCache
+				{
+				private:
+					///Number of bits of the entry index; the table has 2 ^ INDEX_BITS entries.
+					static const int INDEX_BITS = 16;
+					///Number of mutexes guarding the table.
+					static const int LOCKS_COUNT = 16;
+					///Single cached placement.
+					struct Entry
+						{
+						///Placement key, 0 if the entry is empty.
+						boost::uint64_t key;
+						///Fit factor of the placement.
+						int factor;
+						};
+					///Table with all the entries.
+					std::vector<Entry> entries;
+					///Mutexes guarding the entries; entry n is guarded by locks[n % LOCKS_COUNT].
+					boost::mutex locks[LOCKS_COUNT];
+					///Returns the entry index of a key.
+					static unsigned int index(boost::uint64_t key)	{return key >> (64 - INDEX_BITS);}
+				public:
+					///Creates an empty cache.
+					FactorCache();
+					///Finds the factor of a placement.
+					///@param key Placement key, see key().
+					///@param factor Set to the cached factor if the placement is found.
+					///@return True if the placement is found.
+					bool find(boost::uint64_t key, int& factor);
+					///Saves the factor of a placement.
+					///@param key Placement key, see key().
+					///@param factor Factor to save.
+					void store(boost::uint64_t key, int factor);
+					///Removes all the entries.
+					void clear();
+					///Returns the key of a block placement on a cuboid.
+					///@param board Cuboid with the cubes.
+					///@param placed Block at its position (before it is moved forward).
+					static boost::uint64_t key(const Cuboid& board, const Block& placed);
+				};		//class FactorCache
+
 			///Best block position found till the time.
 			///This structure stores the position ((x, y), rotation code, etc.) of the best fitting
 			///block found by process() method. It stores significant data only when the processing is over
@@ -209,46 +331,151 @@ namespace CuTe
 			///@sa rotateBlock(char axis)
 			///@sa countFactor()
 			Block block;
-			///Height of the topmost cube on a cuboid.
-			///Each field on this 2D array represents the height of (x, y) position on a cuboid. If there
-			///are no cubes on whole (x, y) column, the value is -1. If there is one cube right at the
-			///bottom, there is 0, and so on.
-			///@sa countCuboidHeights() where this array is updated.
-			///@sa distance()
-			boost::multi_array<int, 2> cuboidHeights;
-			///Counts the (x, y) cube columns heights on a cuboid.
-			///It searches for the topmost cube on a cube at specified (x, y) column and saves its
-			///z coordinate in cuboidHeights array. This method should be called only once (in
-			///startProcess() before processing all possible rotations, because it does not change
-			///until the block is saved on a cuboid).
-			///@sa distance()
-			void countCuboidHeights();
+			///Positions reachable by the current block.
+			///Found in startProcess() for the current block in its position at that time.
+			///@sa checkAllPositions()
+			MoveGenerator moves;
+			///Which orientations of the current block were already checked.
+			///Many rotations give the same orientation (e.g. any rotation of 1x1x1 cube), every
+			///orientation is checked only once.
+			///@sa BlockShape::orientations()
+			std::vector<bool> checkedOrientations;
+			///Factors of placements evaluated so far.
+			///Kept for the whole game, so that placements evaluated during lookahead aren't evaluated
+			///again when the next block comes.
+			///@sa cachedFactor()
+			mutable FactorCache cache;
 			///Counts the fit factor for all possible (x, y) block positions.
 			///This function is called for all possible rotations (24). It loops through all the
-			///(x, y) block positions and checks whether the block could be put on that place.
+			///(x, y) block positions and checks whether the block could be moved to that place.
 			///If it can, calls countFactor() to compute fit factor for the particular position.
 			///It also saves the block position if it find the factor to be the highest found.<br>
 			///This function is called 24 times for all possible rotations to check all possible
 			///combinations of block positions and rotations.
+			///@param board Cuboid to put the block on.
+			///@param reachable Positions reachable by the block on board.
+			///@param tested Block in tested rotation; its position is changed.
+			///@param found Best block position found so far; updated if better position is found.
 			///@sa process()
 			///@sa block
-			void checkAllPositions();
+			void checkAllPositions(const Cuboid& board, const MoveGenerator& reachable, Block& tested,
+				BlockPos& found) const;
+			///Checks all the remaining rotations at once using worker threads.
+			///Every rotation is checked by checkAllPositions() independently (each thread works on its
+			///own copy of the block), then the results are compared in rotations order. Thanks to that
+			///the best position is exactly the same as when checking the rotations one by one.
+			///@sa threads_
+			///@sa checkRotations()
+			void checkAllRotations();
+			///Worker thread routine used by checkAllRotations().
+			///Takes the next unchecked rotation until there are none left.
+			///@param blocks Block copies, one for every rotation to check.
+			///@param found Best positions found, one for every rotation.
+			///@param next Index of the next rotation to check (shared by all the workers).
+			///@param nextMutex Mutex guarding next.
+			void checkRotations(std::vector<Block>& blocks, std::vector<BlockPos>& found, int& next,
+				boost::mutex& nextMutex) const;
+			///Finds the best placement of the current block looking ahead.
+			///Every placement of the current block is followed by the best placement of the next block
+			///(and of the random ones, if lookahead_ is greater than 2), and the sum of their factors
+			///decides. Placements are examined the best factor first, only LOOKAHEAD_WIDTH of them
+			///and only until lookaheadTime_ elapses; the ones which can't beat the best sum found
+			///are skipped (see factorBound()).
+			///@sa lookahead_
+			///@sa expandCandidates()
+			void checkLookahead();
+			///Worker thread routine used by checkLookahead().
+			///@param search Shared search state.
+			void expandCandidates(Lookahead& search) const;
+			///Finds all the reachable placements of the current block in all its rotations.
+			///@param candidates Vector to store the placements in, in the order checkAllPositions()
+			///would find them.
+			void findCandidates(std::vector<Placement>& candidates);
+			///Finds the best placement of the current block using Monte Carlo rollouts.
+			///Every one of LOOKAHEAD_WIDTH best placements (by factor) is followed by rollouts() random
+			///games of rolloutDepth() blocks (see rollout()), and the placement with the best average
+			///rollout value wins. The rollouts are done in rounds, so the number of rollouts adapts to
+			///the time available: the search stops after rolloutTime() (but not before every candidate
+			///has at least one rollout) or after rollouts() rounds.
+			///@par
+			///The search is spread over many calls, as timeSlice() allows (every rollout started
+			///is finished, though), using threads() threads.
+			///@param analysysTime Time elapsed since process() was called.
+			///@sa monteCarlo
+			void checkRollouts(const MyOGL::Timer& analysysTime);
+			///Worker thread routine used by checkRollouts().
+			///@param analysysTime Time elapsed since process() was called.
+			void runRollouts(const MyOGL::Timer& analysysTime);
+			///Checks whether all the rollouts needed were started.
+			///@note monteCarlo.mutex must be locked by the caller.
+			bool rolloutsDone() const;
+			///Plays a single rollout game.
+			///The candidate is put, then the next block and rolloutDepth() - 1 random blocks are put
+			///greedily (see greedyPlacement()).
+			///@param candidate Current block placement.
+			///@param random Generator of the random blocks.
+			///@return Sum of the factors of all the blocks put; if the game is lost, the part of
+			///LOST_FACTOR for the blocks not put is added.
+			double rollout(const Placement& candidate, Random& random) const;
+			///Finds the best placement of a block by factor.
+			///The block is only dropped from the lowest height at which it is fully inside the cuboid
+			///in every orientation (reachability is not checked as it rarely matters and rollouts must
+			///be cheap).
+			///@param board Cuboid to put the block on.
+			///@param tested Block to put; changed to the best placement found.
+			///@param factor Set to the factor of the best placement.
+			///@return False if the block doesn't fit anywhere.
+			bool greedyPlacement(const Cuboid& board, Block& tested, int& factor) const;
+			///Finds all placements of a block in all of its orientations.
+			///Only the placements reachable from the position in which the block enters the cuboid
+			///are found.
+			///@param board Cuboid to put the block on.
+			///@param tested Block to put in its starting position; its position and orientation are
+			///changed.
+			///@param found Vector to store the placements in.
+			void findPlacements(const Cuboid& board, Block& tested, std::vector<Placement>& found) const;
+			///Puts the block on a cuboid copy.
+			///@param board Cuboid before the block is put.
+			///@param placement Block to put, it is moved forward as far as possible.
+			///@return Cuboid with the block put and filled planes removed.
+			static Cuboid placed(const Cuboid& board, const Placement& placement);
+			///Value of the best placement of a block followed by plies - 1 random blocks.
+			///@param board Cuboid to put the block on.
+			///@param placedBlock Block to put.
+			///@param plies Number of blocks to put (at least 1).
+			///@param timer Time elapsed since the search started.
+			///@return Sum of the factors or LOST_FACTOR if the block doesn't fit anywhere.
+			double placementsValue(const Cuboid& board, const Block& placedBlock, int plies,
+				const MyOGL::Timer& timer) const;
+			///Average placementsValue() over all the blocks available.
+			///@sa Engine::allBlocks()
+			double expectedValue(const Cuboid& board, int plies, const MyOGL::Timer& timer) const;
+			///Upper bound of the factor of any block placement.
+			///@param cubes Number of cubes in a block.
+			///@param lowestZ Lowest z the block cubes can be put at.
+			///@return Value which countFactor() can't exceed.
+			int factorBound(int cubes, int lowestZ) const;
 			///Count the "fit factor" for the block.
 			///This is the essential analyzer engine function. It computes the three sub factors (heights,
 			///distances and edges) for the blocks and sums them depending on their weights.
+			///@param board Cuboid on which the block is put.
+			///@param tested Block to check; it is moved forward during computing but restored before
+			///returning.
 			///@return Integral value fully describing the block position. The bigger this number
 			///the better the block position. So when the engine tries to find the best block position
 			///it simply calls this function for all possible positions and rotations and saves the
 			///one with biggest factor.
 			///@sa checkAllPositions()
-			///@sa HEIGHTS_WEIGHT, DISTS_WEIGHT, EDGES_WEIGHT - sub factor weights
-			int countFactor();
+			///@sa heightsWeight_, distsWeight_, edgesWeight_ - sub factor weights
+			int countFactor(const Cuboid& board, Block& tested) const;
+			///Returns countFactor() result, evaluating the placement only if it isn't cached.
+			///@sa cache
+			int cachedFactor(const Cuboid& board, Block& tested) const;
 			///Currently examined rotation.
 			///There are 24 (ALL_ROTATIONS) possible unique block rotations and the analyzer engine
 			///should check all of them. This variable stores the number of currently tested rotation.
 			///Because process() might be interrupted during testing, this variable can also be used to
 			///know where the process stopped - so it don't test the same rotations again.
-			///@sa transformRot
 			///@sa process()
 			int rotation;
 			///Analyzer state (status).
@@ -260,6 +487,48 @@ namespace CuTe
 			///@sa process()
 			///@sa IDLE, PROCESSING, TRANSFORMING, GAMEOVER
 			int state_;
+			///Number of threads used for processing.
+			///If it is 1, process() checks one rotation at a time and may spread the processing over
+			///several calls. If it is greater, all the rotations are checked at once in a single
+			///process() call by this many threads.
+			///@sa threads()
+			///@sa checkAllRotations()
+			int threads_;
+			///Maximum time (in ms) of a single process() call.
+			///@sa timeSlice()
+			int timeSlice_;
+			///Number of blocks put when looking for the best position.
+			///1 means that only the current block is checked. 2 means that every placement of the
+			///current block is followed by the best placement of the next block. Greater values add
+			///random blocks (the value expected over all the blocks is used).
+			///@sa lookahead()
+			///@sa checkLookahead()
+			int lookahead_;
+			///Time (in ms) after which the lookahead search stops expanding new placements.
+			///@sa lookaheadTime()
+			int lookaheadTime_;
+			///Maximum number of rollouts for every candidate placement, 0 if rollouts are not used.
+			///@sa rollouts()
+			///@sa checkRollouts()
+			int rollouts_;
+			///Number of blocks put in a single rollout after the candidate.
+			///@sa rolloutDepth()
+			int rolloutDepth_;
+			///Time (in ms) after which the rollouts search stops.
+			///@sa rolloutTime()
+			int rolloutTime_;
+			///Rollouts search in progress.
+			///@sa checkRollouts()
+			MonteCarlo monteCarlo;
+			///Heights factor weight, HEIGHTS_WEIGHT by default.
+			///@sa weights()
+			int heightsWeight_;
+			///Distances factor weight, DISTS_WEIGHT by default.
+			///@sa weights()
+			int distsWeight_;
+			///Edges fit factor weight, EDGES_WEIGHT by default.
+			///@sa weights()
+			int edgesWeight_;
 			///Transforms (moves and/or rotates) the current block.
 			///This method is called as many times as needed (till the current block will fit the best
 			///position) when the best block position will be found. Thanks to it the analyzer
@@ -268,17 +537,27 @@ namespace CuTe
 			///@note The function only moves the block horizontally and vertically - pushing the block
 			///forward must be done explicitly if needed.
 			///@sa process()
-			///@sa transformFort
+			///@sa transformStep
 			///@sa TRANSFORMING
 			void transformBlock();
-			///Current transformation rotation.
-			///When the current block is rotated multiple times during transformations in transformBlock()
-			///this variable keeps track on what rotations has already been done and which are still
-			///awaiting.
-			///@sa BlockPos::rotations()
-			///@sa rotation
+			///Starts transforming the current block to the best position.
+			///Finds the steps leading to the best position and changes the state to TRANSFORMING.
+			void startTransforming();
+			///Finds the way to the best position again, starting from the current block position.
+			///@sa transformBlock()
+			void findPath();
+			///Current transformation step.
+			///When the current block is moved and rotated multiple times during transformations in
+			///transformBlock() this variable keeps track on what steps has already been done and which
+			///are still awaiting.
+			///@sa BlockPos::path()
 			///@sa transformBlock()
-			unsigned int transformRot;
+			unsigned int transformStep;
+			///Current block position after the steps done so far.
+			///If the current block is somewhere else (it was moved forward meanwhile or a step was done
+			///only partially), the way is looked for again.
+			///@sa findPath()
+			Block transformed;
 			///Starts processing the new current block.
 			///This method is called once every time the process of new block should start. When it is
 			///called once, the process() method should be called insted (but remember startProcess()
@@ -288,14 +567,6 @@ namespace CuTe
 			///@sa block
 			///@sa process()
 			void startProcess();
-			///Counts the distance between block and cuboid.
-			///The distance value tells how many times we need to push the block saved in block variable
-			///forward so it contact the cuboid cubes. This function is used very often during
-			///computing the fit factor.
-			///@return Distance as described above.
-			///@sa countFactor()
-			///@sa cuboidHeights
-			int distance() const;
 			///Rotates processed block around sopecified axis.
 			///@param axis Code of axis around which we want to rotate; those can letters 'x', 'y' or 'z'
 			///both lower- and uppercase: lowercase means rotating counterclockwise and uppercase is
@@ -324,7 +595,7 @@ namespace CuTe
 			///directly on a current block.
 			///@sa process()
 			///@sa block
-			EngineExt& parent;
+			Engine& parent;
 			///Returns currently available best block position.
 			///@return Class containing some data about best block position found. It's just informing
 			///function because all this information is needed internally in a analyzer during processing
@@ -369,29 +640,129 @@ namespace CuTe
 			///demo.
 			///@sa state()
 			static const int GAMEOVER = 3;
+			///Name of the XML file with the tuned weights profiles.
+			///@sa loadWeights()
+			static const std::string WEIGHTS_FILE_NAME;
 
 			///Makes some initialization work.
 			///@param iParent Parent game engine object.
 			///@param startImmediately If true analyzer will automatically start processing the current
 			///block in the constructor. If false, it will only initialize and wait for explicitly call
 			///to process()
+			///@param iThreads Number of threads used for processing, see threads(int count).
 			///@sa parent
-			BlockAnalyzer(EngineExt& iParent, bool startImmediately = true);
+			BlockAnalyzer(Engine& iParent, bool startImmediately = true, int iThreads = 1);
 			virtual ~BlockAnalyzer()	{}
 			///Main class method used for continue processing.
 			///This function does all the job connected to processing the current block. If you call it
 			///it will start or contunue (depending on the current state) calculations or transformations.
-			///<br>It also keeps eye on time it's being working and if this time exceeds ANALYSYS_MAX_TIME
+			///<br>It also keeps eye on time it's being working and if this time exceeds timeSlice()
 			///it interrupts and waits untill it will be called again. This solution makes a quasi-thread
 			///behaviour which prevents the game to "freeze" for a moment when the analyzer works for too
 			///long.
-			///@sa ANALYSYS_MAX_TIME
+			///@sa timeSlice()
 			///@sa state()
 			virtual void process();
 			///Returns the current analyzer state.
 			///@return State constant, can be one of IDLE, PROCESSING, TRANSFORMING, GAMEOVER
 			///@sa process()
 			virtual int state() const	{return state_;}
+			///Returns the number of threads used for processing.
+			///@sa threads_
+			int threads() const	{return threads_;}
+			///Changes the number of threads used for processing.
+			///With more than one thread the whole processing is done in a single process() call, no
+			///matter how long it takes (timeSlice() is not checked during processing).
+			///@param count Number of threads, at least 1.
+			///@throws CuTeEx when count is less than 1.
+			///@sa threads_
+			void threads(int count);
+			///Returns the maximum time (in ms) of a single process() call.
+			///@sa timeSlice_
+			int timeSlice() const	{return timeSlice_;}
+			///Changes the maximum time of a single process() call.
+			///A call still finishes the step it started (one rotation checked, one transformation),
+			///so keep the slice well below the time the caller can wait.
+			///@param ms New time in ms, ANALYSYS_MAX_TIME by default.
+			///@sa timeSlice_
+			void timeSlice(int ms)	{timeSlice_ = ms;}
+			///Returns the number of blocks put during search.
+			///@sa lookahead_
+			int lookahead() const	{return lookahead_;}
+			///Changes the number of blocks put during search.
+			///With more than one block the whole processing is done in a single process() call, like
+			///with more threads.
+			///@param plies Number of blocks, at least 1.
+			///@throws CuTeEx when plies is less than 1.
+			///@sa lookahead_
+			void lookahead(int plies);
+			///Returns the lookahead time limit (in ms).
+			///@sa lookaheadTime_
+			int lookaheadTime() const	{return lookaheadTime_;}
+			///Changes the lookahead time limit.
+			///@param ms New limit in ms; at least the best placement by factor is always looked ahead.
+			///@sa lookaheadTime_
+			void lookaheadTime(int ms)	{lookaheadTime_ = ms;}
+			///Returns the maximum number of rollouts for every candidate placement.
+			///@sa rollouts_
+			int rollouts() const	{return rollouts_;}
+			///Changes the evaluation strategy.
+			///@param count Maximum number of rollouts for every candidate placement (see
+			///checkRollouts()), 0 to use only countFactor() (and lookahead()).
+			///@throws CuTeEx when count is negative.
+			///@sa rollouts_
+			void rollouts(int count);
+			///Returns the number of blocks put in a single rollout.
+			///@sa rolloutDepth_
+			int rolloutDepth() const	{return rolloutDepth_;}
+			///Changes the number of blocks put in a single rollout.
+			///@throws CuTeEx when depth is less than 1.
+			///@sa rolloutDepth_
+			void rolloutDepth(int depth);
+			///Returns the rollouts time limit (in ms).
+			///@sa rolloutTime_
+			int rolloutTime() const	{return rolloutTime_;}
+			///Changes the rollouts time limit.
+			///@param ms New limit in ms; every candidate gets at least one rollout anyway.
+			///@sa rolloutTime_
+			void rolloutTime(int ms)	{rolloutTime_ = ms;}
+			///Finds the best factor of a block the way process() does, but at once.
+			///Every orientation of the block is checked by checkAllPositions() on the parent cuboid.
+			///The factors cache is used as in process() (weights() forgets it).
+			///@param reachable Positions reachable by the block on the parent cuboid.
+			///@param start Block at its starting position.
+			///@return Fit factor of the best placement found.
+			///@note Meant for measuring the analysis (see cute-bench); it doesn't change the analyzer
+			///state nor the best position found by process().
+			int bestFactor(const MoveGenerator& reachable, const Block& start) const;
+			///Returns the heights factor weight.
+			///@sa heightsWeight_
+			int heightsWeight() const	{return heightsWeight_;}
+			///Returns the distances factor weight.
+			///@sa distsWeight_
+			int distsWeight() const	{return distsWeight_;}
+			///Returns the edges fit factor weight.
+			///@sa edgesWeight_
+			int edgesWeight() const	{return edgesWeight_;}
+			///Changes the sub factor weights used by countFactor().
+			///Factors cached with the old weights are forgotten.
+			///@param heights Heights factor weight.
+			///@param dists Distances factor weight.
+			///@param edges Edges fit factor weight.
+			void weights(int heights, int dists, int edges);
+			///Loads the weights tuned for the parent engine cuboid size and blocks set.
+			///The file contains a <weights> root with <profile> keys, every one with size, blocksSet,
+			///heights, distances and edges attributes (see saveWeights()).
+			///@param fileName Name of the XML file with the profiles.
+			///@return True if a matching profile was found, otherwise the weights are not changed.
+			///@throws MyXML::Exception when the file exists but it's not a valid XML file.
+			bool loadWeights(const std::string& fileName = WEIGHTS_FILE_NAME);
+			///Saves the current weights as the profile for the parent engine cuboid size and blocks set.
+			///Profiles for other sizes and sets already saved in the file are kept.
+			///@param fileName Name of the XML file with the profiles.
+			///@throws MyXML::Exception when the file can't be created.
+			///@sa loadWeights()
+			void saveWeights(const std::string& fileName = WEIGHTS_FILE_NAME) const;
 		};		//class BlockAnalyzer
 
 //----------------------------------------------------------------------------
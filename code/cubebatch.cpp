@@ -0,0 +1,71 @@
+//----------------------------------------------------------------------------
+
+///@file
+///CubeBatch class definitions.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include "cuboidmesh.h"
+#include "cubebatch.h"
+using namespace CuTe;
+
+//----------------------------------------------------------------------------
+
+void CubeBatch::add(float x, float y, float z, float size, const float rgb[3], float alpha)
+	{
+	Instance cube;
+	cube.x = x;
+	cube.y = y;
+	cube.z = z;
+	cube.size = size;
+	for(int i = 0; i < 3; ++i)
+		cube.color[i] = static_cast<unsigned char>(rgb[i] * 255);
+	cube.color[3] = static_cast<unsigned char>(alpha * 255);
+	instances_.push_back(cube);
+	}
+
+const std::vector<CubeBatch::Vertex>& CubeBatch::vertices()
+	{
+	vertices_.resize(instances_.size() * CUBE_VERTICES);
+	std::vector<Vertex>::iterator vertex = vertices_.begin();
+	for(std::vector<Instance>::const_iterator cube = instances_.begin(); cube != instances_.end(); ++cube)
+		for(int face = 0; face < 6; ++face)
+			{
+			const CuboidMesh::Face& cubeFace = CuboidMesh::cubeFaces[face];
+			for(int i = 0; i < CuboidMesh::FACE_VERTICES; ++i, ++vertex)
+				{
+				vertex->s = cubeFace.tex[i][0];
+				vertex->t = cubeFace.tex[i][1];
+				std::copy(cube->color, cube->color + 4, vertex->color);
+				vertex->x = cube->x + cubeFace.corners[i][0] * cube->size;
+				vertex->y = cube->y + cubeFace.corners[i][1] * cube->size;
+				vertex->z = cube->z + cubeFace.corners[i][2] * cube->size;
+				}
+			}
+	return vertices_;
+	}
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,118 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Batch of cubes drawn at once.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#ifndef CUBEBATCH_H
+#define CUBEBATCH_H
+
+//----------------------------------------------------------------------------
+
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+namespace CuTe
+	{
+
+//----------------------------------------------------------------------------
+
+	///Cubes of different positions, sizes and colors drawn with a single draw call.
+	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+	///@date Jul 2005-Mar 2006
+	///@par
+	///The cubes which are drawn only for a moment (current block, next block preview, removed planes)
+	///used to be drawn one by one, each with its own color change, matrix push/pop and display list
+	///call. Now every such a pass adds its cubes (instances) to a batch, which then gives the
+	///vertices of all of them in one array (GL_QUADS with Vertex layout, see GLEngine::drawCubes()).
+	///@par
+	///The instances are expanded to the vertices of the textured cube (see CuboidMesh::cubeFaces)
+	///on the CPU, OpenGL 1.1 has no instanced drawing.
+	///@note The batch doesn't use OpenGL, so it can be filled and checked without any window.
+	class CubeBatch
+		{
+		public:
+			///Single cube in a batch.
+			struct Instance
+				{
+				///Position of the cube middle.
+				float x, y, z;
+				///Length of the cube border.
+				float size;
+				///RGBA color.
+				unsigned char color[4];
+				};
+			///Single vertex of an expanded batch.
+			///Layout is the same as OpenGL GL_T2F_C4UB_V3F interleaved array format.
+			struct Vertex
+				{
+				///Texture coordinates.
+				float s, t;
+				///RGBA color.
+				unsigned char color[4];
+				///Position.
+				float x, y, z;
+				};
+			///Number of vertices of every cube.
+			static const int CUBE_VERTICES = 24;
+		private:
+			///All the cubes in a batch.
+			///@sa instances()
+			std::vector<Instance> instances_;
+			///Vertices of all the cubes.
+			///Kept between the passes so that the memory is allocated only once.
+			///@sa vertices()
+			std::vector<Vertex> vertices_;
+		public:
+			///Removes all the cubes, call it before every pass.
+			void clear()	{instances_.clear();}
+			///Adds a cube to the batch.
+			///@param x X coordinate of the cube middle.
+			///@param y Y coordinate of the cube middle.
+			///@param z Z coordinate of the cube middle.
+			///@param size Length of the cube border.
+			///@param rgb RGB color of the cube.
+			///@param alpha Alpha value of the cube.
+			void add(float x, float y, float z, float size, const float rgb[3], float alpha);
+			///Checks whether there are any cubes in a batch.
+			bool empty() const	{return instances_.empty();}
+			///Returns all the cubes in a batch.
+			const std::vector<Instance>& instances() const	{return instances_;}
+			///Returns the vertices of all the cubes.
+			///@return CUBE_VERTICES vertices for every instance, valid until the next call.
+			const std::vector<Vertex>& vertices();
+		};		//class CubeBatch
+
+//----------------------------------------------------------------------------
+
+	}		//namespace CuTe
+
+//----------------------------------------------------------------------------
+
+#endif
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,206 @@
+//----------------------------------------------------------------------------
+
+///@file
+///CuboidMesh class definitions.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include "cuboidmesh.h"
+using namespace CuTe;
+
+//----------------------------------------------------------------------------
+
+const float CuboidMesh::CUBE_SIZE = 0.99f;
+
+const CuboidMesh::Face CuboidMesh::cubeFaces[6] = {
+	{0, 0, -1, {{-0.5, -0.5, -0.5}, {0.5, -0.5, -0.5}, {0.5, 0.5, -0.5}, {-0.5, 0.5, -0.5}},
+		{{0, 0}, {1, 0}, {1, 1}, {0, 1}}},		//back
+	{-1, 0, 0, {{-0.5, 0.5, -0.5}, {-0.5, -0.5, -0.5}, {-0.5, -0.5, 0.5}, {-0.5, 0.5, 0.5}},
+		{{0, 0}, {1, 0}, {1, 1}, {0, 1}}},		//left
+	{1, 0, 0, {{0.5, -0.5, 0.5}, {0.5, -0.5, -0.5}, {0.5, 0.5, -0.5}, {0.5, 0.5, 0.5}},
+		{{0, 0}, {1, 0}, {1, 1}, {0, 1}}},		//right
+	{0, -1, 0, {{-0.5, -0.5, -0.5}, {0.5, -0.5, -0.5}, {0.5, -0.5, 0.5}, {-0.5, -0.5, 0.5}},
+		{{0, 0}, {1, 0}, {1, 1}, {0, 1}}},		//bottom
+	{0, 1, 0, {{-0.5, 0.5, -0.5}, {-0.5, 0.5, 0.5}, {0.5, 0.5, 0.5}, {0.5, 0.5, -0.5}},
+		{{0, 0}, {1, 0}, {1, 1}, {0, 1}}},		//top
+	{0, 0, 1, {{-0.5, -0.5, 0.5}, {0.5, -0.5, 0.5}, {0.5, 0.5, 0.5}, {-0.5, 0.5, 0.5}},
+		{{0, 0}, {1, 0}, {1, 1}, {0, 1}}}};		//front
+
+void CuboidMesh::update(const Cuboid& cuboid, const std::vector<double>& planesShift)
+	{
+	if(unchanged(cuboid, planesShift))
+		{
+		rebuilt_ = 0;
+		changed_ = false;
+		for(int z = 0; z < depth(); ++z)
+			sources[z] = z;		//every chunk stays where it was
+		return;
+		}
+	shifts = planesShift;
+	const int depth = cuboid.depth();
+	std::vector<Chunk> previous(depth);
+	previous.swap(chunks);
+	std::vector<bool> used(previous.size(), false);
+	sources.assign(depth, -1);
+	rebuilt_ = 0;
+	changed_ = false;
+	for(int z = 0; z < depth; ++z)
+		{
+		Chunk& chunk = chunks[z];
+		chunk.plane = cuboid.plane(z);
+		if((z > 0) && (planesShift[z - 1] == planesShift[z]))
+			chunk.back = cuboid.plane(z - 1);
+		if((z < depth - 1) && (planesShift[z + 1] == planesShift[z]))
+			chunk.front = cuboid.plane(z + 1);
+		//the chunk is most likely at the same z, or moved by the planes removal
+		for(int i = 0; i < static_cast<int>(previous.size()); ++i)
+			{
+			const int old = (z + i) % previous.size();
+			if(!used[old] && chunk.sameKey(previous[old]))
+				{
+				chunk.vertices.swap(previous[old].vertices);
+				used[old] = true;
+				sources[z] = old;
+				break;
+				}
+			}
+		if(sources[z] < 0)
+			{
+			if(greedy)
+				buildGreedy(chunk, cuboid, z);
+			else
+				build(chunk, cuboid, z);
+			++rebuilt_;
+			}
+		changed_ = changed_ || (sources[z] != z);
+		}
+	}
+
+bool CuboidMesh::unchanged(const Cuboid& cuboid, const std::vector<double>& planesShift) const
+	{
+	if((cuboid.depth() != depth()) || (planesShift != shifts))
+		return false;
+	for(int z = 0; z < depth(); ++z)
+		if(!cuboid.samePlane(z, chunks[z].plane))
+			return false;
+	return true;
+	}
+
+void CuboidMesh::build(Chunk& chunk, const Cuboid& cuboid, int z)
+	{
+	chunk.vertices.clear();
+	for(int y = 0; y < cuboid.size(); ++y)
+		for(int x = 0; x < cuboid.size(); ++x)
+			for(int face = 0; face < 6; ++face)
+				if(visible(chunk, cuboid, face, x, y, z))
+					addFace(chunk, face, x, y);
+	}
+
+void CuboidMesh::buildGreedy(Chunk& chunk, const Cuboid& cuboid, int z)
+	{
+	chunk.vertices.clear();
+	const int size = cuboid.size();
+	std::vector<bool> left(size * size);		//visible faces not merged yet
+	for(int face = 0; face < 6; ++face)
+		{
+		for(int y = 0; y < size; ++y)
+			for(int x = 0; x < size; ++x)
+				left[y * size + x] = visible(chunk, cuboid, face, x, y, z);
+		//faces of the neighbour cubes along the face normal are in different planes
+		const bool alongX = (cubeFaces[face].dx == 0);
+		const bool alongY = (cubeFaces[face].dy == 0);
+		for(int y = 0; y < size; ++y)
+			for(int x = 0; x < size; ++x)
+				if(left[y * size + x])
+					{
+					int width = 1;
+					while(alongX && (x + width < size) && left[y * size + x + width])
+						++width;
+					int height = 1;
+					for(bool row = alongY; row && (y + height < size); )
+						{
+						for(int i = 0; row && (i < width); ++i)
+							row = left[(y + height) * size + x + i];
+						if(row)
+							++height;		//whole next row is visible too, add it
+						}
+					for(int j = 0; j < height; ++j)
+						std::fill(left.begin() + (y + j) * size + x, left.begin() + (y + j) * size + x + width, false);
+					addFace(chunk, face, x, y, width, height);
+					}
+		}
+	}
+
+bool CuboidMesh::visible(const Chunk& chunk, const Cuboid& cuboid, int face, int x, int y, int z)
+	{
+	if(!cuboid(x, y, z))
+		return false;
+	const int nx = x + cubeFaces[face].dx;
+	const int ny = y + cubeFaces[face].dy;
+	switch(cubeFaces[face].dz)
+		{
+		case -1: return !(chunk.back && cuboid(x, y, z - 1));
+		case 1: return !(chunk.front && cuboid(x, y, z + 1));
+		}
+	//walls are not drawn, so only the cuboid cubes can hide a face
+	return (nx < 0) || (nx >= cuboid.size()) || (ny < 0) || (ny >= cuboid.size()) || !cuboid(nx, ny, z);
+	}
+
+void CuboidMesh::addFace(Chunk& chunk, int face, int x, int y, int width, int height)
+	{
+	const Face& cube = cubeFaces[face];
+	const int first[3] = {x, y, 0};		//first and last cube covered along every axis
+	const int last[3] = {x + width - 1, y + height - 1, 0};
+	int sAxis = 0;		//texture coordinates go along the axes where the corners differ
+	while(cube.corners[0][sAxis] == cube.corners[1][sAxis])
+		++sAxis;
+	int tAxis = 0;
+	while(cube.corners[1][tAxis] == cube.corners[2][tAxis])
+		++tAxis;
+	for(int i = 0; i < FACE_VERTICES; ++i)
+		{
+		float pos[3];
+		for(int axis = 0; axis < 3; ++axis)
+			pos[axis] = ((cube.corners[i][axis] < 0)? first[axis] : last[axis]) + 0.5f + cube.corners[i][axis] * cubeSize;
+		Vertex vertex;
+		vertex.s = cube.tex[i][0] * (last[sAxis] - first[sAxis] + 1);
+		vertex.t = cube.tex[i][1] * (last[tAxis] - first[tAxis] + 1);
+		vertex.x = pos[0];
+		vertex.y = pos[1];
+		vertex.z = pos[2];
+		chunk.vertices.push_back(vertex);
+		}
+	}
+
+int CuboidMesh::faces() const
+	{
+	int vertices = 0;
+	for(std::vector<Chunk>::const_iterator chunk = chunks.begin(); chunk != chunks.end(); ++chunk)
+		vertices += static_cast<int>(chunk->vertices.size());
+	return vertices / FACE_VERTICES;
+	}
+
+//----------------------------------------------------------------------------
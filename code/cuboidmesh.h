@@ -0,0 +1,210 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Geometry of the cubes saved on a cuboid.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#ifndef CUBOIDMESH_H
+#define CUBOIDMESH_H
+
+//----------------------------------------------------------------------------
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include "engine.h"
+
+//----------------------------------------------------------------------------
+
+namespace CuTe
+	{
+
+//----------------------------------------------------------------------------
+
+	///Vertices of all the visible cube faces of a cuboid, one chunk for every Z plane.
+	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+	///@date Jul 2005-Mar 2006
+	///@par
+	///Drawing the cuboid cube by cube costs a few OpenGL state changes and a display list call for
+	///every cube, and most of the faces drawn are covered by the neighbour cubes anyway. The mesh
+	///has only the faces which are not shared by two cubes, the faces of every Z plane in one
+	///vertex array (chunk), so every plane can be drawn with a single draw call (GL_QUADS with
+	///Vertex layout, see CuboidView).
+	///@par Incremental update
+	///The cuboid changes only when a block is put on it or some planes are removed, so the chunks
+	///are kept between the update() calls and only the chunks of the changed planes are built
+	///again. Cuboid planes are copy-on-write (see Cuboid::plane()), so a plane which holds the same
+	///pointer holds the same cubes: the chunk is reused if its plane and the neighbour planes (which
+	///can hide its front and back faces) are the same. When some planes were removed, the planes
+	///above them only move, so their chunks move with them (see source()) and they are simply drawn
+	///at their current position during the planes shift animation.
+	///@par
+	///Chunks are in the plane coordinates (plane is at z = 0) and have no color, every plane should
+	///be drawn moved to its position and colored (with hue z * PI / 3, like the cubes were always
+	///drawn). Faces between planes moving differently are not hidden, as there is a gap between them.
+	///@par Greedy meshing
+	///On big cuboids even the visible faces are too many. The greedy mesh merges the neighbour
+	///faces lying in the same plane and facing the same direction into the biggest rectangles
+	///possible (the faces of different Z planes never have the same color, so they are not
+	///merged). Texture coordinates of a merged face go from 0 to its length in cubes, so the cube
+	///texture is repeated on every cube (texture must use GL_REPEAT wrapping). Merged cubes have
+	///no gaps between them, only the merged face is a little bit smaller than the cells it covers.
+	///@note The mesh doesn't use OpenGL, so it can be built and checked without any window.
+	class CuboidMesh
+		{
+		public:
+			///Single vertex of a mesh.
+			///Layout is the same as OpenGL GL_T2F_V3F interleaved array format.
+			struct Vertex
+				{
+				///Texture coordinates.
+				float s, t;
+				///Position in cubes (one cube is 1.0 wide), relative to the plane.
+				float x, y, z;
+				};
+			///Number of vertices in every face (faces are quads).
+			static const int FACE_VERTICES = 4;
+			///Default size of the drawn cube relative to the cuboid cell.
+			///Cubes are a little bit smaller than the cells, so that the borders between them are visible.
+			static const float CUBE_SIZE;
+			///Description of one of six cube faces.
+			struct Face
+				{
+				///Direction to the cube which hides the face.
+				int dx, dy, dz;
+				///Corners of the face relative to the cube middle (for cube size 1.0).
+				float corners[FACE_VERTICES][3];
+				///Texture coordinates of the corners.
+				float tex[FACE_VERTICES][2];
+				};
+			///All six cube faces, in the same order and orientation as they were always drawn.
+			///@sa CubeBatch
+			static const Face cubeFaces[6];
+		private:
+			///Faces of a single Z plane and everything they were built from.
+			struct Chunk
+				{
+				///The plane.
+				boost::shared_ptr<const Cuboid::Plane> plane;
+				///Plane behind (z - 1), set only if it hides the back faces.
+				boost::shared_ptr<const Cuboid::Plane> back;
+				///Plane in front (z + 1), set only if it hides the front faces.
+				boost::shared_ptr<const Cuboid::Plane> front;
+				///Faces vertices.
+				std::vector<Vertex> vertices;
+				///Checks whether the chunk was built from the same planes as the other one.
+				bool sameKey(const Chunk& other) const
+					{return (plane == other.plane) && (back == other.back) && (front == other.front);}
+				};
+			///Are the faces merged (see Greedy meshing in the class description).
+			const bool greedy;
+			///Size of the cube relative to the cuboid cell.
+			const float cubeSize;
+			///Chunk of every Z plane.
+			///@sa chunk()
+			std::vector<Chunk> chunks;
+			///Planes shift the chunks were last updated with.
+			///@sa unchanged()
+			std::vector<double> shifts;
+			///Checks whether the cuboid planes and their shifts are the same as in the last update().
+			///Then no chunk has to be built or moved, nor even looked for.
+			bool unchanged(const Cuboid& cuboid, const std::vector<double>& planesShift) const;
+			///Index of the chunk before the last update() which was reused for every plane.
+			///@sa source()
+			std::vector<int> sources;
+			///Number of chunks built in the last update().
+			///@sa rebuilt()
+			int rebuilt_;
+			///Were any chunks built or moved in the last update().
+			///@sa changed()
+			bool changed_;
+			///Builds the chunk vertices from the cuboid.
+			///@param chunk Chunk with the planes set; only the faces not hidden by them are added.
+			///@param cuboid Cuboid the chunk planes come from.
+			///@param z Z coordinate of the chunk plane.
+			void build(Chunk& chunk, const Cuboid& cuboid, int z);
+			///Builds the chunk vertices merging the faces.
+			///@sa build()
+			void buildGreedy(Chunk& chunk, const Cuboid& cuboid, int z);
+			///Checks whether a cube face is visible.
+			///@param chunk Chunk with the planes set.
+			///@param cuboid Cuboid the chunk planes come from.
+			///@param face Index of the face in cubeFaces.
+			///@param x X coordinate of the cube.
+			///@param y Y coordinate of the cube.
+			///@param z Z coordinate of the cube (and the chunk plane).
+			///@return True if there is a cube at (x, y, z) and its face is not hidden.
+			static bool visible(const Chunk& chunk, const Cuboid& cuboid, int face, int x, int y, int z);
+			///Adds a face covering a rectangle of cubes to the chunk.
+			///@param chunk Chunk to add the face to.
+			///@param face Index of the face in cubeFaces.
+			///@param x X coordinate of the first cube.
+			///@param y Y coordinate of the first cube.
+			///@param width Number of cubes covered along X axis.
+			///@param height Number of cubes covered along Y axis.
+			void addFace(Chunk& chunk, int face, int x, int y, int width = 1, int height = 1);
+		public:
+			///Creates an empty mesh.
+			///@param iGreedy Should the faces be merged (see Greedy meshing in the class description).
+			///@param iCubeSize Size of the cube relative to the cuboid cell.
+			explicit CuboidMesh(bool iGreedy = false, float iCubeSize = CUBE_SIZE):
+				greedy(iGreedy), cubeSize(iCubeSize), rebuilt_(0), changed_(false)	{}
+			///Updates the mesh to the cubes saved on a cuboid.
+			///Only the chunks of the changed planes are built again. When no plane has changed nor
+			///moved since the last update, the mesh is not touched at all.
+			///@param cuboid Cuboid to build the mesh of.
+			///@param planesShift Z shift of every plane (see EngineFrame::planesShift). The planes
+			///shifted by a different value don't hide the faces of one another.
+			void update(const Cuboid& cuboid, const std::vector<double>& planesShift);
+			///Returns the number of chunks (cuboid depth).
+			int depth() const	{return static_cast<int>(chunks.size());}
+			///Returns the vertices of a Z plane chunk.
+			///@param z Z coordinate of the plane.
+			///@return Vertices of all the plane faces, FACE_VERTICES in a row for every face.
+			const std::vector<Vertex>& chunk(int z) const	{return chunks[z].vertices;}
+			///Tells where the chunk of a plane was before the last update().
+			///Use it to keep the chunks data (e.g. OpenGL display lists) in step with the mesh.
+			///@param z Z coordinate of the plane.
+			///@return Z coordinate of the same chunk before the update or -1 if the chunk was built in
+			///the update. The same chunk is never reused twice.
+			int source(int z) const	{return sources[z];}
+			///Returns the number of chunks built by the last update().
+			int rebuilt() const	{return rebuilt_;}
+			///Checks whether the last update() changed anything.
+			///@return False if every chunk stayed at its place, so nothing has to be done with the chunks.
+			bool changed() const	{return changed_;}
+			///Returns the number of faces in the mesh.
+			int faces() const;
+		};		//class CuboidMesh
+
+//----------------------------------------------------------------------------
+
+	}		//namespace CuTe
+
+//----------------------------------------------------------------------------
+
+#endif
+
+//----------------------------------------------------------------------------
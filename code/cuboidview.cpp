@@ -0,0 +1,89 @@
+//----------------------------------------------------------------------------
+
+///@file
+///CuboidView class definitions.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#define _USE_MATH_DEFINES		///<for MS VC++ compatibility (M_* are not part of the standard)
+#include <cmath>
+#include "cuboidview.h"
+using namespace CuTe;
+using namespace std;
+
+//----------------------------------------------------------------------------
+
+void CuboidView::draw(Renderer& renderer, const Cuboid& cuboid, const std::vector<double>& planesShift, float border)
+	{
+	mesh_.update(cuboid, planesShift);
+	if(mesh_.changed())
+		updateMeshes(renderer);		//nothing to do in most of the frames
+	renderer.enable(Renderer::TEXTURE);
+	renderer.texture(0);		//select cube texture
+	for(int z = 0; z < mesh_.depth(); ++z)
+		if(meshes[z] != 0)
+			{
+			const float pos = z + planesShift[z];
+			renderer.colorHSV(pos * M_PI / 3, 1.0, 1.0);
+			renderer.pushMatrix();
+			renderer.scale(border, border, border);		//mesh is in cubes
+			renderer.translate(0.0, 0.0, pos);
+			renderer.drawMesh(meshes[z]);
+			renderer.popMatrix();
+			}
+	renderer.disable(Renderer::TEXTURE);
+	}
+
+void CuboidView::updateMeshes(Renderer& renderer)
+	{
+	vector<int> moved(mesh_.depth(), 0);
+	for(int z = 0; z < mesh_.depth(); ++z)
+		{
+		const int source = mesh_.source(z);
+		if(source >= 0)
+			{
+			moved[z] = meshes[source];		//plane didn't change, maybe it moved
+			meshes[source] = 0;
+			}
+		else
+			if(!mesh_.chunk(z).empty())
+				moved[z] = renderer.createMesh(Renderer::QUADS, Renderer::T2F_V3F, &mesh_.chunk(z)[0],
+					static_cast<int>(mesh_.chunk(z).size()));
+		}
+	release(renderer);		//planes which changed or were removed
+	meshes.swap(moved);
+	}
+
+void CuboidView::release(Renderer& renderer)
+	{
+	for(vector<int>::iterator mesh = meshes.begin(); mesh != meshes.end(); ++mesh)
+		if(*mesh != 0)
+			{
+			renderer.deleteMesh(*mesh);
+			*mesh = 0;
+			}
+	}
+
+//----------------------------------------------------------------------------
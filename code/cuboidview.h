@@ -0,0 +1,94 @@
+//----------------------------------------------------------------------------
+
+///@file
+///CuboidView class declaration.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#ifndef CUBOIDVIEW_H
+#define CUBOIDVIEW_H
+
+//----------------------------------------------------------------------------
+
+#include <vector>
+#include "cuboidmesh.h"
+#include "render.h"
+
+//----------------------------------------------------------------------------
+
+namespace CuTe
+	{
+
+//----------------------------------------------------------------------------
+
+	///Draws the cubes saved on a cuboid through a Renderer.
+	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+	///@date Jul 2005-Mar 2006
+	///@par
+	///Keeps a CuboidMesh and a renderer mesh for every its chunk. Only the chunks built again by
+	///CuboidMesh::update() are sent to the renderer, the meshes of the moved chunks are moved with
+	///them (see CuboidMesh::source()). Every Z plane is then drawn with one mesh draw, moved to
+	///its position and colored with hue z * PI / 3.
+	///@note All the meshes belong to the renderer passed to draw(), the view must always be drawn
+	///with the same renderer (and released with it, see release()).
+	class CuboidView
+		{
+		private:
+			///Visible faces of the cubes saved on the cuboid.
+			///@sa mesh()
+			CuboidMesh mesh_;
+			///Renderer mesh of every chunk (Z plane), 0 for empty chunks.
+			///@sa updateMeshes()
+			std::vector<int> meshes;
+			///Moves the meshes after the last CuboidMesh::update() and creates the new ones.
+			///@param renderer Renderer the meshes belong to.
+			void updateMeshes(Renderer& renderer);
+		public:
+			///Creates a view without any meshes.
+			///@param greedy Should the faces be merged (see CuboidMesh).
+			explicit CuboidView(bool greedy = false): mesh_(greedy)	{}
+			///Draws the cubes saved on a cuboid.
+			///The texture is enabled and disabled, all the other states are left untouched.
+			///@param renderer Renderer to draw with.
+			///@param cuboid Cuboid to draw.
+			///@param planesShift Z shift of every plane (see EngineFrame::planesShift).
+			///@param border Distance between two cubes.
+			void draw(Renderer& renderer, const Cuboid& cuboid, const std::vector<double>& planesShift, float border);
+			///Deletes all the meshes.
+			///@param renderer Renderer the view was drawn with.
+			void release(Renderer& renderer);
+			///Returns the mesh of the last drawn cuboid.
+			const CuboidMesh& mesh() const	{return mesh_;}
+		};		//class CuboidView
+
+//----------------------------------------------------------------------------
+
+	}		//namespace CuTe
+
+//----------------------------------------------------------------------------
+
+#endif
+
+//----------------------------------------------------------------------------
@@ -39,7 +39,7 @@ using boost::lexical_cast;
 const float DemoEngine::BlockAnalyzerMsg::VERTICAL_DIST = 0.07;
 
 DemoEngine::BlockAnalyzerMsg::BlockAnalyzerMsg(GLEngine& parent, MyOGL::BitmapFonts& iFonts):
-	BlockAnalyzer(parent), fonts(iFonts)
+	BlockAnalyzer(parent), engine(parent), fonts(iFonts)
 	{
 	}
 
@@ -61,8 +61,9 @@ std::string DemoEngine::BlockAnalyzerMsg::bestStr() const
 	{
 	string s = '(' + lexical_cast<std::string>(best().x()) + ", " + lexical_cast<std::string>(best().y()) + "): [" +
 		lexical_cast<std::string>(best().factor()) + "] ";
-	for(string::const_iterator c = best().rotations().begin(); c != best().rotations().end(); ++c)
-		s += codeToDirection(*c) + ", ";
+	for(MoveGenerator::Path::const_iterator step = best().path().begin(); step != best().path().end(); ++step)
+		if(step->rotation != '\0')
+			s += codeToDirection(step->rotation) + ", ";
 	return s;
 	}
 
@@ -123,7 +124,7 @@ void DemoEngine::BlockAnalyzerMsg::draw()
 
 void DemoEngine::BlockAnalyzerMsg::insert(const std::string& msg)
 	{
-	msgs.push_back(make_pair(timeToFmtStr(parent.gameTime()) + ':', msg));
+	msgs.push_back(make_pair(timeToFmtStr(engine.gameTime()) + ':', msg));
 	if(msgs.size() > ALL_MESSAGES_COUNT)
 		{
 		msgs.pop_front();		//remove the oldest message if list full
@@ -138,18 +139,24 @@ DemoEngine::DemoEngine(const Difficulty& difficulty, MyOGL::Extensions& iExtensi
 	{
 	}
 
-void DemoEngine::update()
+void DemoEngine::update(float tau)
 	{
-	GLEngine::update();
-	switch(static_cast<BlockAnalyzer>(analyzer).state())
+	GLEngine::update(tau);
+	switch(static_cast<const BlockAnalyzer&>(analyzer).state())
 		{
 		//move block forward if all transformations had been done
 		case BlockAnalyzer::IDLE: moveForward(); break;
 		case BlockAnalyzer::GAMEOVER: restart_ = true; break;
-		default: analyzer.process(); break;		//continue processing if its not done
 		}
 	}
 
+void DemoEngine::analyze()
+	{
+	const int state = static_cast<const BlockAnalyzer&>(analyzer).state();
+	if((state == BlockAnalyzer::PROCESSING) || (state == BlockAnalyzer::TRANSFORMING))
+		analyzer.process();		//continue processing if its not done
+	}
+
 void DemoEngine::switchBlocks()
 	{
 	GLEngine::switchBlocks();
@@ -158,8 +165,8 @@ void DemoEngine::switchBlocks()
 
 //----------------------------------------------------------------------------
 
-Demo::Camera::Camera(const Difficulty& difficulty):
-	GLEngine::Camera(difficulty.size(), difficulty.depth(), 3.0), nextUpdateTime(0)
+Demo::Camera::Camera(const Difficulty& difficulty, boost::uint64_t seed):
+	GLEngine::Camera(difficulty.size(), difficulty.depth(), 3.0), nextUpdateTime(0), random(seed)
 	{
 	}
 
@@ -169,17 +176,17 @@ void Demo::Camera::update()
 	if(timer > nextUpdateTime)
 		{
 		timer.restart();
-		nextUpdateTime = 3 * 1024 + rand() % (2 * 1024);		//randomize next update time
-		pos().x() = (rand() % 64 - 32) / 10.0;
-		pos().y() = (rand() % 128 - 64) / 10.0;
-		pos().z() = (rand() % 64 - 24) / 15.0;
+		nextUpdateTime = 3 * 1024 + random(2 * 1024);		//randomize next update time
+		pos().x() = (random(64) - 32) / 10.0;
+		pos().y() = (random(128) - 64) / 10.0;
+		pos().z() = (random(64) - 24) / 15.0;
 		}
 	}
 
 //----------------------------------------------------------------------------
 
 Demo::Demo(CuTeWindow &parentWindow, const Difficulty& difficulty):
-	CuTeScene(parentWindow), engine(difficulty, parentWindow.extensions()), camera(difficulty)
+	CuTeScene(parentWindow), engine(difficulty, parentWindow.extensions()), camera(difficulty, engine.seed() + 2)
 	{
 	}
 
@@ -189,6 +196,9 @@ void Demo::refresh()
 		done();		//exit when [Esc]
 	if(engine.restart())
 		restart();
+	engine.analyze();
+	engine.readFrame();		//tick() published the frame in this same thread
+	engine.interpolate(tickAlpha());
 	drawEngine();
 	drawInfo();
 	drawNextBlock();
@@ -224,20 +234,16 @@ void Demo::drawInfo()
 
 void Demo::drawBackground()
 	{
-	win.extensions().textures().enable();
-	win.extensions().textures().select(1);
-	glColorHSV(0.0, 0.0, 1.0);
-	glBegin(GL_QUADS);
-	glTexCoord2i(0, 0);
-	glVertex2f(-0.5, 0.0);
-	glTexCoord2i(1, 0);
-	glVertex2f(0.5, 0.0);
-	glTexCoord2i(1, 1);
-	glVertex2f(0.5, 1.0);
-	glTexCoord2i(0, 1);
-	glVertex2f(-0.5, 1.0);
-	glEnd();
-	win.extensions().textures().disable();
+	const Renderer::TexVertex logo[] = {
+		{0.0, 0.0, -0.5, 0.0, 0.0},
+		{1.0, 0.0, 0.5, 0.0, 0.0},
+		{1.0, 1.0, 0.5, 1.0, 0.0},
+		{0.0, 1.0, -0.5, 1.0, 0.0}};
+	renderer().enable(Renderer::TEXTURE);
+	renderer().texture(1);
+	renderer().color(1.0, 1.0, 1.0);
+	renderer().draw(Renderer::QUADS, Renderer::T2F_V3F, logo, 4);
+	renderer().disable(Renderer::TEXTURE);
 	}
 
 //----------------------------------------------------------------------------
@@ -133,6 +133,10 @@ namespace CuTe
 					///in update()
 					///@sa update()
 					MyOGL::Timer timer;
+					///Parent engine seen as EngineExt.
+					///BlockAnalyzer only needs plain Engine, but messages are stamped with the game time.
+					///@sa insert()
+					const EngineExt& engine;
 					///Bitmap fonts to use when outputing messages.
 					///Messages are drawn using very small bitmap font. This reference must be given
 					///in constructor.
@@ -160,14 +164,14 @@ namespace CuTe
 			///the current block position.
 			///@sa analyzer
 			void switchBlocks();
-			///Takes care about analyzer processing and block moving.
+			///Takes care about block moving.
 			///If analyzer state is idle, it means that it finished processing and there's nothing left
 			///to do than than just push it forward as far as possible (when it encounter cuboid cubes
-			///switchBlocks() will be called automatically and the processing will start again); otherwise
-			///the BlockAnalyzer::process() method will be called to continue analyzing or transforming
-			///the block
+			///switchBlocks() will be called automatically and the processing will start again).
+			///@param tau Time step in seconds.
 			///@sa analyzer
-			void update();
+			///@sa analyze()
+			void update(float tau);
 			///Block analyzer + message output.
 			///This object is essential for whole demo. The object process the current block, transforms
 			///its positon, rotates it and saves analyzer messages.
@@ -198,6 +202,11 @@ namespace CuTe
 			///Returns the restart flag.
 			///@return restart_ flag to indicate the external environment that the scene should be restarted.
 			bool restart()	{return restart_;}
+			///Continues analyzing or transforming the block.
+			///The analyzer is the demo player, so like the player's input it works once every frame
+			///(BlockAnalyzer::process() takes care about its time itself).
+			///@sa update()
+			void analyze();
 		};		//class DemoEngine: public GLEngine
 
 //----------------------------------------------------------------------------
@@ -231,6 +240,9 @@ namespace CuTe
 					///If the time stored in timer object exceeds this time, the camera position is set
 					///to some random new position.
 					int nextUpdateTime;
+					///Random numbers generator for camera positions.
+					///@sa update()
+					Random random;
 					///Updates the camera position.
 					///Calls the base class version which performs the camera position animation. If the
 					///time stored in timer exceeds the nextUpdateTime, randomizes some new camera position.
@@ -239,7 +251,8 @@ namespace CuTe
 					///Constructor.
 					///@param difficulty Stores the demo game size and depth; this value is used to properly
 					///animate and position the camera.
-					Camera(const Difficulty& difficulty);
+					///@param seed Seed of the camera positions generator.
+					Camera(const Difficulty& difficulty, boost::uint64_t seed);
 				};
 
 			///CuTe engine for handling internall game routines (including block analysis).
@@ -251,6 +264,9 @@ namespace CuTe
 			///Refreshes the scene which is checking for input and drawing all the game parts
 			///(cuboid, next block, messages, etc.)
 			void refresh();
+			///Simulates a single time step of the demo game.
+			///@sa GLEngine::tick()
+			void tick(float tau)	{engine.tick(tau);}
 			///Draws the main game engine parts.
 			///Sets the viewport and draws the game engine: cuboid with cubes and current block.
 			void drawEngine();
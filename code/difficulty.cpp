@@ -35,6 +35,28 @@ using boost::lexical_cast;
 
 //----------------------------------------------------------------------------
 
+//Out-of-class definitions needed when the constants are bound to const references
+//(e.g. by MyXML::readAttrDef()), otherwise GCC fails to link.
+const int Difficulty::SIZE_EASY;
+const int Difficulty::SIZE_MEDIUM;
+const int Difficulty::SIZE_HARD;
+const int Difficulty::DEPTH_EASY;
+const int Difficulty::DEPTH_MEDIUM;
+const int Difficulty::DEPTH_HARD;
+const int Difficulty::SIZE_MIN;
+const int Difficulty::SIZE_MAXX;
+const int Difficulty::DEPTH_MIN;
+const int Difficulty::DEPTH_MAX;
+const int Difficulty::BLOCKS_SET_CLASSIC;
+const int Difficulty::BLOCKS_SET_FLAT;
+const int Difficulty::BLOCKS_SET_EXTREME;
+const int Difficulty::EASY;
+const int Difficulty::MEDIUM;
+const int Difficulty::HARD;
+const int Difficulty::CUSTOM;
+
+//----------------------------------------------------------------------------
+
 bool CuTe::operator<(const DifficultyData& left, const DifficultyData& right)
 	{
 	if(left.size_ < right.size_)
@@ -187,8 +187,9 @@ namespace CuTe
 			///@sa size(int newSize)
 			static const int SIZE_MIN = 5;
 			///Maximum size of a cuboid.
+			///Big cuboids are meant for testing, see CuboidMesh for how they are drawn.
 			///@sa size(int newSize)
-			static const int SIZE_MAXX = 12;
+			static const int SIZE_MAXX = 32;
 			///Minimum depth of a cuboid.
 			///@note Depth values are always odd numbers (9, 11, 13, ...)
 			///@sa depth(int newDepth)
@@ -196,7 +197,7 @@ namespace CuTe
 			///Maximum depth of a cuboid.
 			///@note Depth values are always odd numbers (9, 11, 13, ...)
 			///@sa depth(int newDepth)
-			static const int DEPTH_MAX = 21;
+			static const int DEPTH_MAX = 65;
 			///Classic blocks set.
 			///Blocks set used at Easy difficulty level. Contains classic 2D Tetris blocks.
 			///@sa blocksSet(int newBlocksSet)
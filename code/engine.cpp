@@ -71,17 +71,16 @@ void shift4val(T &e1, T &e2, T &e3, T &e4, bool right = true)
 
 //----------------------------------------------------------------------------
 
-Block::Block(const MyXML::Key& blockData, const Engine& parent)
+BlockShape::BlockShape(const MyXML::Key& blockData)
 	{
+	Cubes blockCubes;
 	int x, y, z;
 	for(x = 0; x < 5; ++x)			//initialize the 3D blockCubes array
 		for(y = 0; y < 5; ++y)
 			for(z = 0; z < 5; ++z)
 				blockCubes[x][y][z] = false;
 	size_ = lexical_cast<int>(blockData.attribute("size"));
-	range_ = size_ / 2;
-	pos_.x() = pos_.y() = parent.size() / 2;
-	pos_.z() = parent.depth() - 1;
+	const int range_ = range();
 	//get all the <xdata> keys by saving iterator pointing to the first key
 	//should be SIZE*SIZE <xdata> keys inside every "block" key
 	MyXML::KeysMap::const_iterator xData = blockData.keys("xdata").first;
@@ -89,26 +88,80 @@ Block::Block(const MyXML::Key& blockData, const Engine& parent)
 		for(y = range_; y >= -range_; --y, ++xData)
 			for(x = 0; x < size_; ++x)
 				blockCubes[x + 2 - range_][y + 2][z + 2] = xData->second.value()[x] == 'X';
+	//rotate the block in every possible way starting from the loaded orientation; every new
+	//arrangement of cubes found becomes the next orientation
+	orientations_.push_back(pack(blockCubes));
+	for(unsigned int index = 0; index < orientations_.size(); ++index)
+		for(int axis = X_AXIS; axis <= Z_AXIS; ++axis)
+			for(int CCW = 0; CCW <= 1; ++CCW)
+				{
+				unpack(orientations_[index], blockCubes);
+				switch(axis)
+					{
+					case X_AXIS: rotateX(blockCubes, range_, CCW != 0); break;
+					case Y_AXIS: rotateY(blockCubes, range_, CCW != 0); break;
+					case Z_AXIS: rotateZ(blockCubes, range_, CCW != 0); break;
+					}
+				const Orientation rotated = pack(blockCubes);
+				unsigned int same;
+				for(same = 0; same < orientations_.size(); ++same)
+					if(equal(&rotated.rows[0][0], &rotated.rows[0][0] + 5 * 5, &orientations_[same].rows[0][0]))
+						break;
+				if(same == orientations_.size())
+					orientations_.push_back(rotated);		//new orientation found
+				orientations_[index].rotated[axis][CCW] = same;
+				}
+	if(orientations_.size() > ALL_ORIENTATIONS)
+		throw CuTeEx("Block has too many orientations");
 	}
 
-bool Block::operator()(int x, int y, int z) const
+BlockShape::Orientation BlockShape::pack(const Cubes& blockCubes)
 	{
-	if((abs(x) > 2) || (abs(y) > 2) || (abs(z) > 2))
-		throw CuTeEx("Block coordinates are out of range");
-	return blockCubes[2 + x][2 + y][2 + z];
+	Orientation orientation;
+	for(int y = -2; y <= 2; ++y)
+		for(int z = -2; z <= 2; ++z)
+			{
+			Line line = {y, z, 0};
+			for(int x = -2; x <= 2; ++x)
+				if(blockCubes[x + 2][y + 2][z + 2])
+					{
+					line.bits |= 1u << (x + 2);
+					orientation.cubes.push_back(Point<int, 3>(x, y, z));
+					}
+			orientation.rows[y + 2][z + 2] = line.bits;
+			if(line.bits != 0)
+				orientation.lines.push_back(line);
+			}
+	for(int x = -2; x <= 2; ++x)
+		for(int y = -2; y <= 2; ++y)
+			for(int z = -2; z <= 2; ++z)
+				if(blockCubes[x + 2][y + 2][z + 2])
+					{
+					orientation.bottom.push_back(Point<int, 3>(x, y, z));
+					break;		//only the lowest cube in a column
+					}
+	return orientation;
 	}
 
-void Block::rotateX(bool CCW)
+void BlockShape::unpack(const Orientation& orientation, Cubes& blockCubes)
+	{
+	for(int x = 0; x < 5; ++x)
+		for(int y = 0; y < 5; ++y)
+			for(int z = 0; z < 5; ++z)
+				blockCubes[x][y][z] = (orientation.rows[y][z] >> x) & 1;
+	}
+
+void BlockShape::rotateX(Cubes& blockCubes, int blockRange, bool CCW)
 	{
 	int x;
-	if(range_ > 0)		//block is at least 3x3x3
-		for(x = 2 - range_; x <= 2 + range_; ++x)
+	if(blockRange > 0)		//block is at least 3x3x3
+		for(x = 2 - blockRange; x <= 2 + blockRange; ++x)
 			{
 			shift4val(blockCubes[x][3][3], blockCubes[x][1][3], blockCubes[x][1][1], blockCubes[x][3][1], CCW);
 			shift4val(blockCubes[x][3][2], blockCubes[x][2][3], blockCubes[x][1][2], blockCubes[x][2][1], CCW);
 			}
-		if(range_ > 1)		//block's size is 5x5x5
-			for(x = 2 - range_; x <= 2 + range_; ++x)
+		if(blockRange > 1)		//block's size is 5x5x5
+			for(x = 2 - blockRange; x <= 2 + blockRange; ++x)
 				{
 				shift4val(blockCubes[x][4][4], blockCubes[x][0][4], blockCubes[x][0][0], blockCubes[x][4][0], CCW);
 				shift4val(blockCubes[x][3][4], blockCubes[x][0][3], blockCubes[x][1][0], blockCubes[x][4][1], CCW);
@@ -117,17 +170,17 @@ void Block::rotateX(bool CCW)
 				}
 	}
 
-void Block::rotateY(bool CCW)
+void BlockShape::rotateY(Cubes& blockCubes, int blockRange, bool CCW)
 	{
 	int y;
-	if(range_ > 0)		//block is at least 3x3x3x
-		for(y = 2 - range_; y <= 2 + range_; ++y)
+	if(blockRange > 0)		//block is at least 3x3x3x
+		for(y = 2 - blockRange; y <= 2 + blockRange; ++y)
 			{
 			shift4val(blockCubes[3][y][3], blockCubes[3][y][1], blockCubes[1][y][1], blockCubes[1][y][3], CCW);
 			shift4val(blockCubes[3][y][2], blockCubes[2][y][1], blockCubes[1][y][2], blockCubes[2][y][3], CCW);
 			}
-		if(range_ > 1)		//block's size is 5x5x5
-			for(y = 2 - range_; y <= 2 + range_; ++y)
+		if(blockRange > 1)		//block's size is 5x5x5
+			for(y = 2 - blockRange; y <= 2 + blockRange; ++y)
 				{
 				shift4val(blockCubes[4][y][0], blockCubes[0][y][0], blockCubes[0][y][4], blockCubes[4][y][4], CCW);
 				shift4val(blockCubes[4][y][1], blockCubes[1][y][0], blockCubes[0][y][3], blockCubes[3][y][4], CCW);
@@ -136,18 +189,18 @@ void Block::rotateY(bool CCW)
 				}
 	}
 
-void Block::rotateZ(bool CCW)
+void BlockShape::rotateZ(Cubes& blockCubes, int blockRange, bool CCW)
 	{
 	int z;
-	if(range_ > 0)		//block is at least 3x3x3x
+	if(blockRange > 0)		//block is at least 3x3x3x
 		{
-		for(z = 2 - range_; z <= 2 + range_; ++z)
+		for(z = 2 - blockRange; z <= 2 + blockRange; ++z)
 			{
 			shift4val(blockCubes[3][3][z], blockCubes[1][3][z], blockCubes[1][1][z], blockCubes[3][1][z], CCW);
 			shift4val(blockCubes[2][3][z], blockCubes[1][2][z], blockCubes[2][1][z], blockCubes[3][2][z], CCW);
 			}
-		if(range_ > 1)		//block's size is 5x5x5
-			for(z = 2 - range_; z <= 2 + range_; ++z)
+		if(blockRange > 1)		//block's size is 5x5x5
+			for(z = 2 - blockRange; z <= 2 + blockRange; ++z)
 				{
 				shift4val(blockCubes[4][4][z], blockCubes[0][4][z], blockCubes[0][0][z], blockCubes[4][0][z], CCW);
 				shift4val(blockCubes[3][4][z], blockCubes[0][3][z], blockCubes[1][0][z], blockCubes[4][1][z], CCW);
@@ -159,150 +212,332 @@ void Block::rotateZ(bool CCW)
 
 //----------------------------------------------------------------------------
 
-void Engine::Points::addNewBlock(const Block &block)
+Block::Block(const BlockShape& shape, const Engine& parent): shape_(&shape), orientation_(0)
 	{
-	int cubes = 0;
-	for(int x = -block.range(); x <= block.range(); ++x)
-		for(int y = -block.range(); y <= block.range(); ++y)
-			for(int z = -block.range(); z <= block.range(); ++z)
-				if(block(x, y, z))
-					++cubes;
-	points += (cubes * 3 - 2) * multiplier;
+	pos_.x() = pos_.y() = parent.size() / 2;
+	pos_.z() = parent.depth() - 1;
 	}
 
-void Engine::Points::cheat()
+bool Block::operator()(int x, int y, int z) const
 	{
-	if(points <= CHEAT_MIN_POINTS)
-		points = 0;
-	else
-		if(points <= 2 * CHEAT_MIN_POINTS)
-			points -= CHEAT_MIN_POINTS;
-		else
-			points /= 2;
+	if((abs(x) > 2) || (abs(y) > 2) || (abs(z) > 2))
+		throw CuTeEx("Block coordinates are out of range");
+	return (row(y, z) >> (2 + x)) & 1;
 	}
 
 //----------------------------------------------------------------------------
 
-Engine::Engine(const Difficulty& difficulty):
-	cuboid(boost::extents[difficulty.size() + 2 * WALL_THICKNESS]
-		[difficulty.size() + 2 * WALL_THICKNESS]
-		[difficulty.depth() + 2 * WALL_THICKNESS]), removedPlanes(difficulty.depth() + 1),
-	points_(difficulty.size()), size_(difficulty.size()), depth_(difficulty.depth())
-	{
-	cuboid.reindex(-WALL_THICKNESS);		//start all indexes from -WALL_THICKNESS
-	loadBlocks(difficulty.blocksSet());
-	for(int z = -WALL_THICKNESS; z < depth_ + WALL_THICKNESS; ++z)
-		for(int y = -WALL_THICKNESS; y < size_ + WALL_THICKNESS; ++y)
-			for(int x = -WALL_THICKNESS; x < size_ + WALL_THICKNESS; ++x)
-				cuboid[x][y][z] = (x < 0) || (x >= size_) || (y < 0) || (y >= size_) || (z < 0) || (z >= depth_);
-	current = getRandomBlock();
-	for(int z = 0; z <= current.range(); ++z, --current.pos().z())
-		if(canPut(current))		//move block forward as much, as it is needed to put it on a cuboid
-			break;
-	next = getRandomBlock();
+int Cuboid::checkedSize(int size)
+	{
+	if((size <= 0) || (size + 2 * WALL_THICKNESS >= ROW_BITS))
+		throw CuTeEx("Wrong cuboid size: " + lexical_cast<string>(size));
+	return size;
 	}
 
-void Engine::loadBlocks(int blocksSet)
+Cuboid::Cuboid(int iSize, int iDepth):
+	size_(checkedSize(iSize)), depth_(iDepth), planeRows(size_ + 2 * WALL_THICKNESS),
+	fullRow((~Row()) >> (ROW_BITS - size_ - 2 * WALL_THICKNESS)),
+	wallRow(fullRow & ~(((~Row()) >> (ROW_BITS - size_)) << WALL_THICKNESS)),
+	emptyPlane(new Plane(planeRows, fullRow)), planeCubes(iDepth), cuboidCubes(0), heights(size_ * size_, -1), hash_(0)
 	{
-	MyXML::Key blocksData("data/blocks.xml");		//read the data.xml's blocks data
-	std::pair<MyXML::KeysMap::const_iterator, MyXML::KeysMap::const_iterator> blocksRange =
-		blocksData.keys("block");		//find all "block" keys
-	for(MyXML::KeysMap::const_iterator i = blocksRange.first; i != blocksRange.second; ++i)
-		//load block only if its set is less or equal the choosen one
-		if(lexical_cast<int>(i->second.attribute("set")) <= blocksSet)
-			blocks.push_back(new Block(i->second, *this));		//save created Block object
+	for(int y = 0; y < size_; ++y)
+		(*emptyPlane)[y + WALL_THICKNESS] = wallRow;
+	const boost::shared_ptr<Plane> wallPlane(new Plane(planeRows, fullRow));
+	planes.assign(depth_ + 2 * WALL_THICKNESS, emptyPlane);
+	for(int z = 0; z < WALL_THICKNESS; ++z)
+		planes[z] = planes[depth_ + WALL_THICKNESS + z] = wallPlane;
+	}
+
+Cuboid::Row& Cuboid::mutableRow(int y, int z)
+	{
+	boost::shared_ptr<Plane>& rowPlane = planes[z + WALL_THICKNESS];
+	if(!rowPlane.unique())
+		rowPlane.reset(new Plane(*rowPlane));		//someone else uses this plane too, make own copy
+	return (*rowPlane)[y + WALL_THICKNESS];
 	}
 
-bool Engine::operator()(int x, int y, int z) const
+bool Cuboid::operator()(int x, int y, int z) const
 	{
 	if((x >= size_ + WALL_THICKNESS) || (x <= -WALL_THICKNESS) ||
 		(y >= size_ + WALL_THICKNESS) || (y <= -WALL_THICKNESS) ||
 		(z >= depth_ + WALL_THICKNESS) || (z <= -WALL_THICKNESS))
 			throw CuTeEx("Coordinates in cuboid are out of range");
-	return cuboid[x][y][z];
+	return (row(y, z) >> (x + WALL_THICKNESS)) & 1;
 	}
 
-bool Engine::canPut(const Block &block) const
+bool Cuboid::canPut(const Block &block) const
 	{
-	for(int x = -block.range(); x <= block.range(); ++x)
-		for(int y = -block.range(); y <= block.range(); ++y)
-			for(int z = -block.range(); z <= block.range(); ++z)
-				if(block(x, y, z) && cuboid[x + block.pos().x()][y + block.pos().y()][z + block.pos().z()])
-					return false;		//collision: there's a cube in a block and in a cuboid
+	const int shift = block.pos().x() + WALL_THICKNESS - 2;
+	const std::vector<BlockShape::Line>& lines = block.lines();
+	for(std::vector<BlockShape::Line>::const_iterator line = lines.begin(); line != lines.end(); ++line)
+		{
+		const int cuboidY = block.pos().y() + line->y;
+		const int cuboidZ = block.pos().z() + line->z;
+		if((cuboidY < -WALL_THICKNESS) || (cuboidY >= size_ + WALL_THICKNESS) ||
+			(cuboidZ < -WALL_THICKNESS) || (cuboidZ >= depth_ + WALL_THICKNESS) ||
+			((shift < 0) && (line->bits & ((1u << -shift) - 1))))
+				return false;		//block sticks out even beyond the walls
+		const Row placed = blockRowAt(line->bits, block.pos().x());
+		if((placed & row(cuboidY, cuboidZ)) || (placed & ~fullRow))
+			return false;		//collision: there's a cube in a block and in a cuboid
+		}
 	return true;
 	}
 
-bool Engine::filledPlane(int z)
+bool Cuboid::tryMove(Block &block) const
+	{
+	int shift;		//how many fields did the block was moved to finish rotation
+	for(shift = 0; block.pos().x() - block.range() < 0; ++shift)
+		{		//too close to the left wall
+		++block.pos().x();
+		if(canPut(block))
+			return true;
+		}
+	block.pos().x() -= shift;		//still can't rotate, move back to start position
+	for(shift = 0; block.pos().x() + block.range() > size_ - 1; ++shift)
+		{		//too close to the left wall
+		--block.pos().x();
+		if(canPut(block))
+			return true;
+		}
+	block.pos().x() += shift;
+	for(shift = 0; block.pos().y() - block.range() < 0; ++shift)
+		{		//too close to the floor
+		++block.pos().y();
+		if(canPut(block))
+			return true;
+		}
+	block.pos().y() -= shift;
+	for(shift = 0; block.pos().y() + block.range() > size_ - 1; ++shift)
+		{		//too close to the ceiling
+		--block.pos().y();
+		if(canPut(block))
+			return true;
+		}
+	block.pos().y() += shift;
+	for(shift = 0; block.pos().z() + block.range() > depth_ - 1; ++shift)
+		{
+		--block.pos().z();
+		if(canPut(block))
+			return true;
+		}
+	block.pos().z() += shift;
+	return false;
+	}
+
+bool Cuboid::enter(Block &block) const
 	{
-	for(int x = 0; x < size(); ++x)
-		for(int y = 0; y < size(); ++y)
-			if(!cuboid[x][y][z])
-				return false;
-	return true;
+	for(int z = 0; z <= block.range(); ++z, --block.pos().z())
+		if(canPut(block))		//move block forward as much, as it is needed to put it on a cuboid
+			return true;
+	return false;
 	}
 
-void Engine::removeFilledPlanes()
+void Cuboid::put(const Block& block)
 	{
-	int x, y, z;
-	for(z = 0; z <= depth_; ++z)
-		removedPlanes[z] = filledPlane(z);		//mark planes to be removed
-	z = 0;
-	while(!removedPlanes[z])
-		++z;		//first filled plane (may be the end, which means there were no filled planes found)
-	int moved = 0;		//how many plames should move back
-	while(z < depth_)
+	const std::vector<BlockShape::Line>& lines = block.lines();
+	for(std::vector<BlockShape::Line>::const_iterator line = lines.begin(); line != lines.end(); ++line)
 		{
-		while(removedPlanes[z])		//find first plane to be moved
+		const int z = block.pos().z() + line->z;
+		Row& cuboidRow = mutableRow(block.pos().y() + line->y, z);
+		const Row placed = blockRowAt(line->bits, block.pos().x());
+		const Row addedBits = placed & ~cuboidRow;		//walls and cubes already there don't count
+		const int added = bitsCount(addedBits);
+		cuboidRow |= placed;
+		if((z >= 0) && (z < depth_))
 			{
-			++z;
+			planeCubes[z] += added;
+			cuboidCubes += added;
+			for(int x = 0; (x < size_) && (addedBits >> (x + WALL_THICKNESS)); ++x)
+				if((addedBits >> (x + WALL_THICKNESS)) & 1)
+					hash_ ^= cubeKey(x, block.pos().y() + line->y, z);
+			}
+		}
+	const std::vector<Point<int, 3> >& cubes = block.cubes();
+	for(std::vector<Point<int, 3> >::const_iterator cube = cubes.begin(); cube != cubes.end(); ++cube)
+		{		//raise columns heights
+		const int x = block.pos().x() + cube->x();
+		const int y = block.pos().y() + cube->y();
+		const int z = block.pos().z() + cube->z();
+		if((x >= 0) && (x < size_) && (y >= 0) && (y < size_) && (z < depth_) && (z > height(x, y)))
+			heights[y * size_ + x] = z;
+		}
+	}
+
+int Cuboid::removeFilledPlanes(std::vector<bool>& removed)
+	{
+	int y, z;
+	int moved = 0;		//how many plames should move back
+	for(z = 0; z < depth_; ++z)
+		{
+		removed[z] = filledPlane(z);		//mark planes to be removed
+		if(removed[z])
 			++moved;
+		else if(moved > 0)		//move whole plane back
+			{
+			planes[z - moved + WALL_THICKNESS] = planes[z + WALL_THICKNESS];
+			planeCubes[z - moved] = planeCubes[z];
 			}
-		int last = z + 1;		//last - plane after the last to be moved
-		while(!removedPlanes[last])
-			++last;
-		for(; z < last; ++z)
-			for(y = 0; y < size_; ++y)
-				for(x = 0; x < size_; ++x)
-					cuboid[x][y][z - moved] = cuboid[x][y][z];		//move cubes back
 		}
 	if(moved > 0)		//do any moves only if some planes were actually removed
 		{
 		for(z = depth_ - moved; z < depth_; ++z)		//clear the most top planes if some planes were removed
-			for(y = 0; y < size_; ++y)
-				for(x = 0; x < size_; ++x)
-					cuboid[x][y][z] = false;
-		points_.addFilledPlanes(moved);		//moved stores the number of removed planes
-		if(empty())
-			points_.addBonus();		//add bonus points if whole cuboid empty
+			{
+			planes[z + WALL_THICKNESS] = emptyPlane;
+			planeCubes[z] = 0;
+			}
+		cuboidCubes -= moved * size_ * size_;
+		std::vector<int> removedBelow(depth_ + 1, 0);		//how many planes were removed below z
+		for(z = 0; z < depth_; ++z)
+			removedBelow[z + 1] = removedBelow[z] + removed[z];
+		for(y = 0; y < size_; ++y)
+			for(int x = 0; x < size_; ++x)
+				{
+				int& columnTop = heights[y * size_ + x];
+				if(columnTop >= 0)		//cubes above the removed planes went down
+					columnTop = columnHeight(x, y, columnTop - removedBelow[columnTop + 1]);
+				}
+		rehash();
+		}
+	return moved;
+	}
+
+void Cuboid::rehash()
+	{
+	hash_ = 0;
+	for(int z = 0; z < depth_; ++z)
+		for(int y = 0; y < size_; ++y)
+			for(int x = 0; x < size_; ++x)
+				if((row(y, z) >> (x + WALL_THICKNESS)) & 1)
+					hash_ ^= cubeKey(x, y, z);
+	}
+
+int Cuboid::dropDistance(const Block& block) const
+	{
+	int dist = depth_;
+	const std::vector<Point<int, 3> >& bottom = block.bottom();
+	for(std::vector<Point<int, 3> >::const_iterator cube = bottom.begin(); cube != bottom.end(); ++cube)
+		{
+		const int x = block.pos().x() + cube->x();
+		const int y = block.pos().y() + cube->y();
+		if((x < 0) || (x >= size_) || (y < 0) || (y >= size_))
+			{
+			dist = -1;		//block in the wall, heights are useless
+			break;
+			}
+		const int columnDist = block.pos().z() + cube->z() - height(x, y) - 1;
+		if(columnDist < 0)
+			{
+			dist = -1;		//cuboid cube over the block, heights are useless
+			break;
+			}
+		dist = min(dist, columnDist);
+		}
+	if(dist >= 0)
+		return dist;
+	Block moved = block;
+	dist = 0;
+	--moved.pos().z();
+	while(canPut(moved))
+		{
+		--moved.pos().z();		//move block forward as far as it is possible
+		++dist;
+		}
+	return dist;
+	}
+
+int Cuboid::columnHeight(int x, int y, int z) const
+	{
+	for(; z >= 0; --z)
+		if((row(y, z) >> (x + WALL_THICKNESS)) & 1)
+			break;
+	return z;
+	}
+
+//----------------------------------------------------------------------------
+
+void Points::addNewBlock(const Block &block)
+	{
+	const int cubes = block.cubes().size();
+	points += (cubes * 3 - 2) * multiplier;
+	}
+
+void Points::cheat()
+	{
+	if(points <= CHEAT_MIN_POINTS)
+		points = 0;
+	else
+		if(points <= 2 * CHEAT_MIN_POINTS)
+			points -= CHEAT_MIN_POINTS;
+		else
+			points /= 2;
+	}
+
+//----------------------------------------------------------------------------
+
+Engine::Engine(const Difficulty& difficulty, boost::uint64_t seed):
+	state_(difficulty.size(), difficulty.depth(), seed), removedPlanes(difficulty.depth()),
+	size_(difficulty.size()), depth_(difficulty.depth()), blocksSet_(difficulty.blocksSet())
+	{
+	loadBlocks(blocksSet_);
+	state_.current = getRandomBlock();
+	state_.cuboid.enter(state_.current);
+	state_.next = getRandomBlock();
+	}
+
+void Engine::state(const EngineState& saved)
+	{
+	if((saved.cuboid.size() != size_) || (saved.cuboid.depth() != depth_))
+		throw CuTeEx("Engine state of another cuboid size");
+	state_ = saved;
+	fill(removedPlanes.begin(), removedPlanes.end(), false);
+	}
+
+void Engine::loadBlocks(int blocksSet)
+	{
+	MyXML::Key blocksData("data/blocks.xml");		//read the data.xml's blocks data
+	std::pair<MyXML::KeysMap::const_iterator, MyXML::KeysMap::const_iterator> blocksRange =
+		blocksData.keys("block");		//find all "block" keys
+	for(MyXML::KeysMap::const_iterator i = blocksRange.first; i != blocksRange.second; ++i)
+		//load block only if its set is less or equal the choosen one
+		if(lexical_cast<int>(i->second.attribute("set")) <= blocksSet)
+			shapes.push_back(new BlockShape(i->second));		//save created BlockShape object
+	for(std::vector<const BlockShape*>::const_iterator shape = shapes.begin(); shape != shapes.end(); ++shape)
+		blocks.push_back(Block(**shape, *this));
+	}
+
+void Engine::removeFilledPlanes()
+	{
+	const int moved = state_.cuboid.removeFilledPlanes(removedPlanes);
+	if(moved > 0)		//do any moves only if some planes were actually removed
+		{
+		state_.points.addFilledPlanes(moved);		//moved stores the number of removed planes
+		if(state_.cuboid.empty())
+			state_.points.addBonus();		//add bonus points if whole cuboid empty
 		}
 	}
 
 void Engine::switchBlocks()
 	{
-	int x, y, z;
-	points_.addNewBlock(current);		//add points for current block
-	for(z = -current.range(); z <= current.range(); ++z)
-		for(y = -current.range(); y <= current.range(); ++y)
-			for(x = -current.range(); x <= current.range(); ++x)
-				if(current(x, y, z))		//saves a current block on a cuboid
-					cuboid[current.pos().x() + x][current.pos().y() + y][current.pos().z() + z] = true;
+	state_.points.addNewBlock(state_.current);		//add points for current block
+	state_.cuboid.put(state_.current);		//saves a current block on a cuboid
 	removeFilledPlanes();		//if some Z plane is filled with cubes, remove it
-	current = next;
-	next = getRandomBlock();
-	for(z = 0; z <= current.range(); ++z, --current.pos().z())
-		if(canPut(current))		//move block forward as much, as it is needed to put it on a cuboid
-			return;
-	gameOver();		//new block can't be put on the cuboid, game is overed
+	state_.current = state_.next;
+	state_.next = getRandomBlock();
+	if(!state_.cuboid.enter(state_.current))
+		gameOver();		//new block can't be put on the cuboid, game is overed
 	}
 
 bool Engine::move(int shiftX, int shiftY)
 	{
-	current.pos().y() += shiftY;		//temporarily move block up
-	current.pos().x() += shiftX;
-	if(!canPut(current))
+	recordEvent((shiftX != 0)? ((shiftX < 0)? ReplayRecorder::MOVE_LEFT : ReplayRecorder::MOVE_RIGHT) :
+		((shiftY > 0)? ReplayRecorder::MOVE_UP : ReplayRecorder::MOVE_DOWN));
+	state_.current.pos().y() += shiftY;		//temporarily move block up
+	state_.current.pos().x() += shiftX;
+	if(!canPut(state_.current))
 		{
-		current.pos().y() -= shiftY;		//block can't be placed uppper
-		current.pos().x() -= shiftX;
+		state_.current.pos().y() -= shiftY;		//block can't be placed uppper
+		state_.current.pos().x() -= shiftX;
 		return false;
 		}
 	return true;
@@ -310,59 +545,24 @@ bool Engine::move(int shiftX, int shiftY)
 
 bool Engine::moveForward()
 	{
-	--current.pos().z();		//temporarily move block further to the screen
-	if(canPut(current))
+	recordEvent(ReplayRecorder::MOVE_FORWARD);
+	--state_.current.pos().z();		//temporarily move block further to the screen
+	if(canPut(state_.current))
 		return true;
-	++current.pos().z();		//block can't be placed further
+	++state_.current.pos().z();		//block can't be placed further
 	switchBlocks();		//so it is saved on a cuboid
 	return false;
 	}
 bool Engine::tryMove(Block &block)
 	{
-	int shift;		//how many fields did the block was moved to finish rotation
-	for(shift = 0; block.pos().x() - block.range() < 0; ++shift)
-		{		//too close to the left wall
-		++block.pos().x();
-		if(canPut(block))
-			return true;
-		}
-	block.pos().x() -= shift;		//still can't rotate, move back to start position
-	for(shift = 0; block.pos().x() + block.range() > size_ - 1; ++shift)
-		{		//too close to the left wall
-		--block.pos().x();
-		if(canPut(block))
-			return true;
-		}
-	block.pos().x() += shift;
-	for(shift = 0; block.pos().y() - block.range() < 0; ++shift)
-		{		//too close to the floor
-		++block.pos().y();
-		if(canPut(block))
-			return true;
-		}
-	block.pos().y() -= shift;
-	for(shift = 0; block.pos().y() + block.range() > size_ - 1; ++shift)
-		{		//too close to the ceiling
-		--block.pos().y();
-		if(canPut(block))
-			return true;
-		}
-	block.pos().y() += shift;
-	for(shift = 0; block.pos().z() + block.range() > depth_ - 1; ++shift)
-		{
-		--block.pos().z();
-		if(canPut(block))
-			return true;
-		}
-	block.pos().z() += shift;
-	return false;
+	return state_.cuboid.tryMove(block);
 	}
 
 bool Engine::tryPut(Block &block)
 	{
 	if(canPut(block) || tryMove(block))
 		{		//block can be placed on a cuboid after rotation (and optionally after additional move)
-		current = block;		//replace current cube with temporary
+		state_.current = block;		//replace current cube with temporary
 		return true;
 		}
 	else
@@ -371,67 +571,54 @@ bool Engine::tryPut(Block &block)
 
 bool Engine::rotateXCW()
 	{
-	Block temp = current;		//creates temporary copy of a current block
+	recordEvent(ReplayRecorder::ROTATE_XCW);
+	Block temp = state_.current;		//creates temporary copy of a current block
 	temp.rotateX(false);		//rotates a copy
 	return tryPut(temp);		//try to put onto the cuboid
 	}
 
 bool Engine::rotateXCCW()
 	{
-	Block temp = current;		//creates temporary copy of a current block
+	recordEvent(ReplayRecorder::ROTATE_XCCW);
+	Block temp = state_.current;		//creates temporary copy of a current block
 	temp.rotateX(true);		//rotates a copy
 	return tryPut(temp);		//try to put onto the cuboid
 	}
 
 bool Engine::rotateYCW()
 	{
-	Block temp = current;		//creates temporary copy of a current block
+	recordEvent(ReplayRecorder::ROTATE_YCW);
+	Block temp = state_.current;		//creates temporary copy of a current block
 	temp.rotateY(false);		//rotates a copy
 	return tryPut(temp);		//try to put onto the cuboid
 	}
 
 bool Engine::rotateYCCW()
 	{
-	Block temp = current;		//creates temporary copy of a current block
+	recordEvent(ReplayRecorder::ROTATE_YCCW);
+	Block temp = state_.current;		//creates temporary copy of a current block
 	temp.rotateY(true);		//rotates a copy
 	return tryPut(temp);		//try to put onto the cuboid
 	}
 
 bool Engine::rotateZCW()
 	{
-	Block temp = current;		//creates temporary copy of a current block
+	recordEvent(ReplayRecorder::ROTATE_ZCW);
+	Block temp = state_.current;		//creates temporary copy of a current block
 	temp.rotateZ(false);		//rotates a copy
 	return tryPut(temp);		//try to put onto the cuboid
 	}
 
 bool Engine::rotateZCCW()
 	{
-	Block temp = current;		//creates temporary copy of a current block
+	recordEvent(ReplayRecorder::ROTATE_ZCCW);
+	Block temp = state_.current;		//creates temporary copy of a current block
 	temp.rotateZ(true);		//rotates a copy
 	return tryPut(temp);		//try to put onto the cuboid
 	}
 
 int Engine::distance()
 	{
-	int dist = 0;
-	--current.pos().z();
-	while(canPut(current))
-		{
-		--current.pos().z();		//move block forward as far as it is possible
-		++dist;
-		}
-	current.pos().z() += dist + 1;		//move block back to its start position
-	return dist;
-	}
-
-bool Engine::empty() const
-	{
-	for(int x = 0; x < size(); ++x)
-		for(int y = 0; y < size(); ++y)
-			for(int z = 0; z < depth(); ++z)
-				if(cuboid[x][y][z])
-					return false;		//return false if any cubes were found
-	return true;
+	return dropDistance(state_.current);
 	}
-
 //----------------------------------------------------------------------------
@@ -33,9 +33,14 @@
 //----------------------------------------------------------------------------
 
 #include <vector>
-#include <boost/multi_array.hpp>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 #include "common.h"
 #include "point.h"
+#include "random.h"
+#include "replay.h"
 #include "difficulty.h"
 
 //----------------------------------------------------------------------------
@@ -63,6 +68,107 @@ namespace CuTe
 
 	class Engine;		//forward declaration
 
+	///All orientations of a single block.
+	///@par
+	///Every block can be rotated around X, Y and Z axis by the multiplication of 90 degrees, which
+	///gives at most 24 different orientations. This class loads the block cubes once and computes
+	///all of them in advance together with the table of rotations between them, so rotating a
+	///Block is only a matter of changing its orientation index.
+	///@par
+	///Orientations are unique: if two rotations of a symmetric block produce exactly the same cubes,
+	///they are stored only once (the 1x1x1 cube has a single orientation).
+	///@sa Block
+	class BlockShape
+		{
+		public:
+			///Maximum number of different block orientations.
+			static const int ALL_ORIENTATIONS = 24;
+			///X axis code used by rotate().
+			static const int X_AXIS = 0;
+			///Y axis code used by rotate().
+			static const int Y_AXIS = 1;
+			///Z axis code used by rotate().
+			static const int Z_AXIS = 2;
+
+			///Single line of cubes parallel to X axis.
+			///Only non-empty lines are stored, so the cuboid can be checked against them directly.
+			struct Line
+				{
+				///Y coordinate of the line in <-2; 2> range.
+				int y;
+				///Z coordinate of the line in <-2; 2> range.
+				int z;
+				///Cubes on a line; bit 0 is x = -2, bit 4 is x = 2.
+				unsigned int bits;
+				};
+
+			///Block cubes in one particular orientation.
+			struct Orientation
+				{
+				///Cubes packed into bit rows, indexed [y + 2][z + 2].
+				///@sa Line::bits for the bits meaning.
+				unsigned char rows[5][5];
+				///All non-empty rows.
+				std::vector<Line> lines;
+				///Coordinates of all the cubes.
+				std::vector<Point<int, 3> > cubes;
+				///Lowest cube in every non-empty (x, y) column.
+				///Only these cubes can touch the cuboid when the block moves forward.
+				///@sa Engine::dropDistance()
+				std::vector<Point<int, 3> > bottom;
+				///Orientation indexes after rotation, indexed [axis][CCW].
+				///@sa rotate()
+				int rotated[3][2];
+				};
+
+			///Loads the block and computes all its orientations.
+			///@param blockData XML key containing an information about the block size, set and most
+			///important a set of "xdata" keys with coded block information (cubes).
+			///@sa Engine::loadBlocks() for the details about blockData key structure.
+			BlockShape(const MyXML::Key& blockData);
+			///Returns size of a block.
+			///Can be one of: 1, 3, 5 (must be an odd number)
+			int size() const	{return size_;}
+			///Returns range of block cubes (size / 2).
+			int range() const	{return size_ / 2;}
+			///Returns the number of unique orientations.
+			int orientations() const	{return orientations_.size();}
+			///Returns the cubes in specified orientation.
+			///@param index Orientation index in range <0; orientations())
+			const Orientation& orientation(int index) const	{return orientations_[index];}
+			///Rotation look-up.
+			///@param index Orientation before rotation.
+			///@param axis One of X_AXIS, Y_AXIS, Z_AXIS.
+			///@param CCW If true, rotates counterclockwise, otherwise clockwise
+			///@return Orientation index after rotation.
+			int rotate(int index, int axis, bool CCW) const	{return orientations_[index].rotated[axis][CCW];}
+		private:
+			///All cubes which the block is built in (used only while computing orientations).
+			///@note cubes[2][2][2] is just in the middle of a block
+			typedef bool Cubes[5][5][5];
+			///Size of a block.
+			int size_;
+			///All unique orientations; orientation 0 is the one loaded from XML.
+			std::vector<Orientation> orientations_;
+			///Rotates cubes around X axis.
+			///@param blockCubes Cubes to rotate.
+			///@param blockRange Range of the block (rotating only <-blockRange; blockRange> cubes).
+			///@param CCW If true, rotates counterclockwise, otherwise clockwise
+			static void rotateX(Cubes& blockCubes, int blockRange, bool CCW);
+			///Rotates cubes around Y axis.
+			///@sa rotateX()
+			static void rotateY(Cubes& blockCubes, int blockRange, bool CCW);
+			///Rotates cubes around Z axis.
+			///@sa rotateX()
+			static void rotateZ(Cubes& blockCubes, int blockRange, bool CCW);
+			///Builds Orientation data (without rotations table) from cubes array.
+			static Orientation pack(const Cubes& blockCubes);
+			///Restores cubes array from Orientation data.
+			static void unpack(const Orientation& orientation, Cubes& blockCubes);
+		};
+
+//----------------------------------------------------------------------------
+
 	///All data and actions connected to blocks.
 	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
 	///@date Jul 2005-Mar 2006
@@ -70,23 +176,22 @@ namespace CuTe
 	///In this class there are information about size of a block, particular cubes which the block
 	///is built from and the position of a block in a cuboid.
 	///Besides the class deliver essential method for rotating and moving block block.
+	///@par
+	///The cubes themselves are kept in a shared BlockShape, Block only stores which of its
+	///orientations is used. Thanks to that Block objects are very cheap to copy.
 	class Block
 		{
 		private:
-			///All cubes which the block is built in.
-			///@note blockCubes[2][2][2] is just in the middle of a block
-			///@sa operator()(int x, int y, int z) const
-			bool blockCubes[5][5][5];
-			///Size of a block.
-			///Can be one of: 1, 3, 5 (must be an odd number)
-			int size_;
-			///The range of cubes in a block.
-			///Although the cubes data is a simple array, operator() uses non-typical array indexes
-			///<-range; range>. Thanks to that cube (0, 0, 0) is right in the middle (no corner)
-			///@sa operator()(int x, int y, int z) const
-			int range_;
+			///Shape of a block with all its orientations.
+			///NULL in default constructed object.
+			const BlockShape* shape_;
+			///Current orientation index in shape_.
+			///@sa BlockShape::orientation()
+			int orientation_;
 			///Position of a block in a game cuboid.
 			Point<int, 3> pos_;
+			///Rotates block using BlockShape look-up table.
+			void rotate(int axis, bool CCW)	{if(shape_ != NULL) orientation_ = shape_->rotate(orientation_, axis, CCW);}
 		public:
 			///Default constructor.
 			///Sometimes the Block object must be created without loading some actual block data onto it.
@@ -95,25 +200,24 @@ namespace CuTe
 			///@par
 			///You can always check whether the Block object is "empty" (default constructed): the size()
 			///method will return zero (in properly constructed object this should be at leat 1).
-			///@sa Block(const MyXML::Key& blockData, const Engine& parent);
-			Block(): size_(0), range_(0)	{}
+			///@sa Block(const BlockShape& shape, const Engine& parent);
+			Block(): shape_(NULL), orientation_(0)	{}
 			///Normal object constructor.
-			///This constructor creates a Block object and loads the block data from a XML key given as
-			///a parameter.
-			///@param blockData XML key containing an information about the block size, set and most
-			///important a set of "xdata" keys with coded block information (cubes).
+			///This constructor creates a Block object in initial orientation of a given shape.
+			///@param shape Block shape. It must live at least as long as the Block object.
 			///@param parent Parent game engine object, needed to obtain the information about the game
 			///size and depth (the block is positioned properly after initialization).
-			///@sa Engine::loadBlocks() for the details about blockData key structure.
-			Block(const MyXML::Key& blockData, const Engine& parent);
+			///@sa Engine::loadBlocks()
+			Block(const BlockShape& shape, const Engine& parent);
 			///Returns size of a block
 			///@return Size of a block
-			///@sa size_
-			int size() const	{return size_;}
+			///@sa BlockShape::size()
+			int size() const	{return (shape_ != NULL)? shape_->size() : 0;}
 			///Returns range of block cubes
+			///Although the cubes are stored in a simple array, operator() uses non-typical array indexes
+			///<-range; range>. Thanks to that cube (0, 0, 0) is right in the middle (no corner)
 			///@return Range of block cubes
-			///@sa range_ for more information
-			int range() const	{return range_;}
+			int range() const	{return (shape_ != NULL)? shape_->range() : 0;}
 			///Overloaded operator ().
 			///You can read whether at specified field in block there is or isn't a cube.
 			///Just type b(0, 1, -2), where b is an object of type Block.
@@ -126,6 +230,32 @@ namespace CuTe
 			///will be thrown when the absolute value of a coordinate exceed 2), but you are able to
 			///read every cube in a block no matter how big the block is (exceed range value).
 			bool operator()(int x, int y, int z) const;
+			///Returns the cubes on a single line parallel to X axis.
+			///@param y Y coordinate of the line. Can be in range <-2; 2>
+			///@param z Z coordinate of the line. Can be in range <-2; 2>
+			///@return Bit mask of cubes on (y, z) line; bit 0 is x = -2, bit 4 is x = 2.
+			unsigned int row(int y, int z) const
+				{return (shape_ != NULL)? shape_->orientation(orientation_).rows[2 + y][2 + z] : 0;}
+			///Returns all non-empty lines of cubes parallel to X axis.
+			///@warning Must not be called on default constructed Block.
+			const std::vector<BlockShape::Line>& lines() const	{return shape_->orientation(orientation_).lines;}
+			///Returns coordinates of all the cubes in a block.
+			///@warning Must not be called on default constructed Block.
+			const std::vector<Point<int, 3> >& cubes() const	{return shape_->orientation(orientation_).cubes;}
+			///Returns the lowest cube in every column of a block.
+			///@warning Must not be called on default constructed Block.
+			///@sa BlockShape::Orientation::bottom
+			const std::vector<Point<int, 3> >& bottom() const	{return shape_->orientation(orientation_).bottom;}
+			///Returns the block shape.
+			///@return Pointer to the shape or NULL in default constructed object.
+			const BlockShape* shape() const	{return shape_;}
+			///Returns current orientation index.
+			///@sa BlockShape::orientation()
+			int orientation() const	{return orientation_;}
+			///Changes block orientation.
+			///@param index Orientation index in range <0; shape()->orientations())
+			///@sa BlockShape::orientation()
+			void orientation(int index)	{orientation_ = index;}
 			///Returns current block position.
 			///This function allows only to read the block position.
 			///@return (x, y, z) position of a block (cube located right in the middle)
@@ -140,125 +270,388 @@ namespace CuTe
 			///@param CCW If true, rotates counterclockwise, otherwise clockwise
 			///@sa Engine::rotateXCW()
 			///@sa Engine::rotateXCCW()
-			void rotateX(bool CCW);
+			void rotateX(bool CCW)	{rotate(BlockShape::X_AXIS, CCW);}
 			///Rotates block around Y axis.
 			///@param CCW If true, rotates counterclockwise, otherwise clockwise
 			///@sa Engine::rotateYCW()
 			///@sa Engine::rotateYCCW()
-			void rotateY(bool CCW);
+			void rotateY(bool CCW)	{rotate(BlockShape::Y_AXIS, CCW);}
 			///Rotates block around Z axis.
 			///@param CCW If true, rotates counterclockwise, otherwise clockwise
 			///@sa Engine::rotateZCW()
 			///@sa Engine::rotateZCCW()
-			void rotateZ(bool CCW);
+			void rotateZ(bool CCW)	{rotate(BlockShape::Z_AXIS, CCW);}
 		};
 
 //----------------------------------------------------------------------------
 
-	///Essential data for CuTe game engine.
-	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
-	///@date Jul 2005-Mar 2006
+	///Game cuboid with all the cubes saved on it.
 	///@par
-	///In this class there are stored cuboid and blocks data.
-	///Some most important method are here: rotation, ability to put block in specific place,
-	///loading blocks from file, etc.
-	class Engine
+	///Every (y, z) line of a cuboid (walls included) is packed into a single 64-bit Row, so checking
+	///a whole line of block cubes for collisions is just one AND operation. Besides the cubes the
+	///class keeps the number of cubes in every Z plane and the height of every (x, y) column, which
+	///are updated when a block is put or planes are removed.
+	///@par
+	///Cuboid is a plain value: it can be copied to try some block placements without touching the
+	///game itself (this is what BlockAnalyzer does when looking ahead).
+	///@par Copy-on-write planes
+	///Z planes are shared between the copies of a cuboid and a plane is copied only when it is
+	///changed for the first time, so copying the cuboid copies no cubes at all and putting a block
+	///on a copy copies only the planes the block lies in. Removing filled planes just moves the
+	///planes pointers.
+	///@sa Engine
+	class Cuboid
 		{
-		private:
-
-			///Point counter classes for CuTe.
-			///This class counts points which the user have achieved in the game so far.
-			///It encapsulates the points adding routins, so that the environment class doesn't have to
-			///take care about them.
-			class Points
-				{
-				private:
-					///Minimum amout of points to take away when cheating.
-					///When user cheats during the game, game takes him away half of his points, but it must
-					///be at least CHEAT_MIN_POINTS.
-					///@sa cheat()
-					static const int CHEAT_MIN_POINTS = 10000;
-					///Width and height of the associated CuTe cuboid.
-					const int GAME_SIZE;
-					///Points count (0 at the beginning)
-					int points;
-					///Points multiplier.
-					///All added points will be multiplied by this valie.
-					///@par
-					///This value default to 1, which means to multiplication at all.
-					///@sa mul() for more details.
-					int multiplier;
-				public:
-					///Constructor.
-					///@param gameSize Width and height of a game.
-					///@sa GAME_SIZE
-					Points(int gameSize): GAME_SIZE(gameSize), points(0), multiplier(1)	{}
-					///Adds points if some plane(s) were removed.
-					///@param planesCount How many planes were removed at the same time; the more planes
-					///removed, the bigger point bonus player will achieve.
-					void addFilledPlanes(int planesCount)
-						{points += sqr(GAME_SIZE) * GAME_SIZE * sqr(planesCount) * multiplier;}
-					///Adds some points after block was saved on a cuboid.
-					///The bigger the block was (was built from more cubes), the more point will be added.
-					///@param block Block which you want to count and add points.
-					void addNewBlock(const Block &block);
-					///Bonus points for cleaning whole cuboid.
-					///When after removing filled planes there are no cubes on cuboid left at all,
-					///you'll get a bonus points.
-					void addBonus()	{points += sqr(sqr(GAME_SIZE)) * multiplier;}
-					///Overloaded conversion perator int().
-					///Thanks to this operator you may read points from Points object really simple.
-					operator int() const	{return points;}
-					///Sets the points multiplier.
-					///This feature can be used somewhere in your game to multiply all points which user
-					///got by some specified value. I use it to multiply all the points by the speed level
-					/// - so that the bigger speed, the more points user get.
-					///@sa multiplier.
-					void mul(int newMultiplier)	{multiplier = newMultiplier;}
-					///Take away some points when user cheats.
-					///When user cheats during the game, game takes him away half of points which he got so far,
-					///but it must be at least CHEAT_MIN_POINTS.
-					///@sa CHEAT_MIN_POINTS
-					void cheat();
-				};
-
+		public:
 			///Thickness of a game cuboid walls.
 			///This additional wall is invisible for the user, but is used when checking if the block can be
 			///put in near the wall. The wall is simply treated as a solid bunch of cubes so that canPut()
 			///method has simplier work: it only checks for cubes collisions since walls are cubes too.
-			///@sa cuboid
+			///@sa rows
 			static const int WALL_THICKNESS = 2;
-			///3D matrix corresponding to main game cuboid.
-			///If on location (x, y, z) there is true, it means that there is a cube
-			///(only solid cubes are stored here, not the cubes which are a part of currently visible Block).
+			///Single cuboid bitboard row.
+			///One row holds all the cubes of a (y, z) line parallel to X axis, including the walls: bit
+			///n corresponds to x = n - WALL_THICKNESS.
+			///@sa planes
+			typedef boost::uint64_t Row;
+			///All the rows of a single Z plane, starting from y = -WALL_THICKNESS.
+			///@sa planes
+			typedef std::vector<Row> Plane;
+			///Number of bits in a Row.
+			///Cuboid size plus both walls can't exceed this value.
+			static const int ROW_BITS = 64;
+		private:
+			///Size of cuboid (width and height).
+			int size_;
+			///Depth of a cuboid.
+			int depth_;
+			///Number of rows in a single Z plane (size with both walls).
+			///@sa Plane
+			int planeRows;
+			///Row completely filled with cubes (walls included).
+			///@sa filledPlane()
+			Row fullRow;
+			///Row with walls only.
+			///This is how every row inside an empty cuboid looks like.
+			Row wallRow;
+			///Bitboard with all the cubes.
+			///Z planes (walls included) starting from z = -WALL_THICKNESS. If on location (x, y, z) there
+			///is a bit set, it means that there is a cube (only solid cubes are stored here, not the cubes
+			///which are a part of currently visible Block).
+			///@par
+			///Planes are shared by the cuboid copies (and all the empty planes by one another), see
+			///mutableRow().
 			///@note (x, y) = (0, 0) is the down left corner in a cuboid Z plane. Greater z, nearer the user we are
 			///(z = 0 is the furthest Z plane)
+			///@sa row()
 			///@sa operator()(int x, int y, int z)
-			boost::multi_array<bool, 3> cuboid;
+			std::vector<boost::shared_ptr<Plane> > planes;
+			///Empty Z plane (only walls), shared by all the empty planes.
+			///@sa removeFilledPlanes()
+			boost::shared_ptr<Plane> emptyPlane;
+			///Number of cubes in every Z plane (walls not counted).
+			///Kept up to date by put() and removeFilledPlanes() so that filledPlane() does not have to
+			///scan the plane.
+			///@sa cuboidCubes
+			std::vector<int> planeCubes;
+			///Number of all cubes in a cuboid (walls not counted).
+			///@sa empty()
+			///@sa planeCubes
+			int cuboidCubes;
+			///Height of every (x, y) column, indexed [y * size_ + x].
+			///Height is the z coordinate of the topmost cube in a column or -1 if there are no cubes in
+			///it. Updated in put() and removeFilledPlanes().
+			///@sa height()
+			///@sa dropDistance()
+			std::vector<int> heights;
+			///Zobrist hash of all the cubes in a cuboid.
+			///This is the XOR of cubeKey() of every cube, so putting a block changes it only by the
+			///keys of the block cubes.
+			///@sa hash()
+			boost::uint64_t hash_;
+			///Checks whether the cuboid of a given size fits in a Row.
+			///Used in the constructor before the rows are computed from the size.
+			///@param size Cuboid width and height.
+			///@return The same size.
+			///@throws CuTeEx when the size is not positive or the cuboid with walls doesn't fit in a Row.
+			static int checkedSize(int size);
+			///Returns the random-like key of a cube at (x, y, z).
+			///@sa hash_
+			static boost::uint64_t cubeKey(int x, int y, int z)
+				{return mix((static_cast<boost::uint64_t>(z) << 40) ^ (static_cast<boost::uint64_t>(y) << 20) ^ x);}
+			///Counts hash_ from scratch.
+			///Used when planes were removed and most of the cubes moved.
+			void rehash();
+			///Gives access to a single cuboid row for changing it.
+			///If the row plane is shared with another cuboid (or it is the empty plane), it is copied
+			///first.
+			///@param y Y coordinate of the row, in range <-WALL_THICKNESS; size_ + WALL_THICKNESS)
+			///@param z Z coordinate of the row, in range <-WALL_THICKNESS; depth_ + WALL_THICKNESS)
+			///@return Reference to the (y, z) Row in cuboid.
+			Row& mutableRow(int y, int z);
+			///Gives read-only access to a single cuboid row.
+			///@sa mutableRow()
+			Row row(int y, int z) const	{return (*planes[z + WALL_THICKNESS])[y + WALL_THICKNESS];}
+			///Moves block row onto cuboid row bits.
+			///@param blockRow Block row as returned by Block::row().
+			///@param x X coordinate of the block middle cube.
+			///@return Block row shifted so that it can be directly compared with cuboid Row.
+			static Row blockRowAt(unsigned int blockRow, int x)
+				{
+				const int shift = x + WALL_THICKNESS - 2;
+				return (shift >= 0)? static_cast<Row>(blockRow) << shift : static_cast<Row>(blockRow) >> -shift;
+				}
+			///Counts bits set in a row.
+			///@param bits Row to count.
+			///@return Number of bits set in bits (number of cubes in a row).
+			static int bitsCount(Row bits)
+				{
+				int count = 0;
+				for(; bits; bits &= bits - 1)
+					++count;
+				return count;
+				}
+			///Finds the topmost cube in a column.
+			///@param x X coordinate of a column.
+			///@param y Y coordinate of a column.
+			///@param z Z coordinate to start searching from (downwards).
+			///@return Z coordinate of the first cube found at or below z, or -1 if there are none.
+			int columnHeight(int x, int y, int z) const;
+		public:
+			///Mixes bits of a value so that similar values give completely different results.
+			///@param value Value to mix.
+			///@return Mixed value; the same value always gives the same result.
+			static boost::uint64_t mix(boost::uint64_t value)
+				{
+				value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+				return value ^ (value >> 31);
+				}
+			///Creates an empty cuboid.
+			///@param iSize Cuboid width and height.
+			///@param iDepth Cuboid depth.
+			///@throws CuTeEx when the size is not positive or the cuboid with walls doesn't fit in a Row.
+			Cuboid(int iSize, int iDepth);
+			///Returns the cuboid size.
+			int size() const	{return size_;}
+			///Returns the cuboid depth.
+			int depth() const	{return depth_;}
+			///Returns a Z plane.
+			///A plane is copied before it is changed whenever it is shared (see mutableRow()), so as
+			///long as the returned pointer is held, the plane it points to never changes and a plane
+			///with the same pointer has the same cubes.
+			///@param z Z coordinate of the plane, in range <0; depth_)
+			///@return Shared pointer to the plane rows.
+			boost::shared_ptr<const Plane> plane(int z) const	{return planes[z + WALL_THICKNESS];}
+			///Checks whether a Z plane is the given one, without copying the plane pointer.
+			///@param z Z coordinate of the plane.
+			///@param other Plane returned by plane() before.
+			///@return True if the plane has the same pointer (so the same cubes) as other.
+			///@sa plane()
+			bool samePlane(int z, const boost::shared_ptr<const Plane>& other) const
+				{return planes[z + WALL_THICKNESS] == other;}
+			///Reading cuboid data.
+			///@param x X coordinate in range (-WALL_THICKNESS; size_ + WALL_THICKNESS) (walls are
+			///available too).
+			///@param y Y coordinate; see x for more details and range.
+			///@param z Z coordinate; see x for more details and range (depth_ instead of size_).
+			///@return True if on specified (x, y, z) position there is a cube.
+			///@throws CuTeEx when the coordinates are out of range.
+			bool operator()(int x, int y, int z) const;
+			///Checkes whether block can be put on cuboid without collisions.
+			///@param block Block which should be checked
+			///@return True if specified block can be put in the cuboid without collision
+			bool canPut(const Block &block) const;
+			///Tries to move block if it is close to the walls and doesn't fit after rotation.
+			///See Engine::tryMove() for the rules.
+			///@param block Block after rotation; moved to the new position if one was found.
+			///@return True if the block fits after the move, otherwise false (block remains in place).
+			bool tryMove(Block &block) const;
+			///Moves a new block forward until it fits on a cuboid.
+			///Block enters the cuboid at its top; if there are cubes there, it is moved forward at most
+			///block range + 1 times.
+			///@param block New block, in its starting position.
+			///@return True if the block fits, false if it doesn't (game is over).
+			bool enter(Block &block) const;
+			///Returns the height of a cuboid column.
+			///@param x X coordinate of a column in range <0; size_)
+			///@param y Y coordinate of a column in range <0; size_)
+			///@return Z coordinate of the topmost cube in (x, y) column or -1 if the column is empty.
+			///@sa heights
+			int height(int x, int y) const	{return heights[y * size_ + x];}
+			///Counts how far the block can be moved forward.
+			///Normally the distance is taken from the columns heights under the lowest cubes of the
+			///block, so no collision checking is needed. Only if some cuboid cube lies over the block
+			///(the block was moved under an overhang) or the block doesn't fit in the cuboid at all,
+			///the distance is found by moving the block forward step by step.
+			///@param block Block to check; normally it should be possible to put it on a cuboid.
+			///@return How many times block can be moved forward without collision.
+			///@sa height()
+			int dropDistance(const Block& block) const;
+			///Is the specified Z plane fully filled by cubes.
+			///@param z Z plane which you want to check.
+			///@return True if specified plane is fully filled with cubes. Otherwise false.
+			///@sa planeCubes
+			bool filledPlane(int z) const	{return planeCubes[z] == size_ * size_;}
+			///Checks whether the whole cuboid is empty.
+			///@return True if no cubes left on a cuboid. Otherwise false.
+			///@sa cuboidCubes
+			bool empty() const	{return cuboidCubes == 0;}
+			///Returns the hash of all the cubes in a cuboid.
+			///Cuboids with the same cubes (and the same size) have the same hash, so it can be used
+			///as a key of results computed for a cuboid.
+			///@sa hash_
+			boost::uint64_t hash() const	{return hash_;}
+			///Saves block cubes on a cuboid.
+			///Planes filled by the block are not removed, call removeFilledPlanes() for that.
+			///@param block Block to save, normally it should be possible to put it on a cuboid.
+			void put(const Block& block);
+			///Removes all filled Z planes.
+			///Planes above the removed ones are moved back, the most top planes become empty.
+			///@param removed Marks of removed planes, removed[z] is set to true if plane z was removed;
+			///must have at least depth() elements.
+			///@return Number of planes removed.
+			int removeFilledPlanes(std::vector<bool>& removed);
+		};		//class Cuboid
+
+//----------------------------------------------------------------------------
+
+	///Point counter classes for CuTe.
+	///This class counts points which the user have achieved in the game so far.
+	///It encapsulates the points adding routins, so that the environment class doesn't have to
+	///take care about them.
+	///@par
+	///Points is a plain value, so it is a part of EngineState.
+	class Points
+		{
+		private:
+			///Minimum amout of points to take away when cheating.
+			///When user cheats during the game, game takes him away half of his points, but it must
+			///be at least CHEAT_MIN_POINTS.
+			///@sa cheat()
+			static const int CHEAT_MIN_POINTS = 10000;
+			///Width and height of the associated CuTe cuboid.
+			int gameSize;
+			///Points count (0 at the beginning)
+			int points;
+			///Points multiplier.
+			///All added points will be multiplied by this valie.
+			///@par
+			///This value default to 1, which means to multiplication at all.
+			///@sa mul() for more details.
+			int multiplier;
+		public:
+			///Constructor.
+			///@param gameSize Width and height of a game.
+			///@sa gameSize
+			Points(int iGameSize): gameSize(iGameSize), points(0), multiplier(1)	{}
+			///Adds points if some plane(s) were removed.
+			///@param planesCount How many planes were removed at the same time; the more planes
+			///removed, the bigger point bonus player will achieve.
+			void addFilledPlanes(int planesCount)
+				{points += sqr(gameSize) * gameSize * sqr(planesCount) * multiplier;}
+			///Adds some points after block was saved on a cuboid.
+			///The bigger the block was (was built from more cubes), the more point will be added.
+			///@param block Block which you want to count and add points.
+			void addNewBlock(const Block &block);
+			///Bonus points for cleaning whole cuboid.
+			///When after removing filled planes there are no cubes on cuboid left at all,
+			///you'll get a bonus points.
+			void addBonus()	{points += sqr(sqr(gameSize)) * multiplier;}
+			///Overloaded conversion perator int().
+			///Thanks to this operator you may read points from Points object really simple.
+			operator int() const	{return points;}
+			///Sets the points multiplier.
+			///This feature can be used somewhere in your game to multiply all points which user
+			///got by some specified value. I use it to multiply all the points by the speed level
+			/// - so that the bigger speed, the more points user get.
+			///@sa multiplier.
+			void mul(int newMultiplier)	{multiplier = newMultiplier;}
+			///Take away some points when user cheats.
+			///When user cheats during the game, game takes him away half of points which he got so far,
+			///but it must be at least CHEAT_MIN_POINTS.
+			///@sa CHEAT_MIN_POINTS
+			void cheat();
+		};		//class Points
+
+//----------------------------------------------------------------------------
+
+	///Whole changing state of a game.
+	///Everything that changes while the game is played: the cuboid, both blocks, the points and the
+	///blocks generator. Engine keeps its state in this structure, so the game can be saved with
+	///Engine::state() and restored later with Engine::state(const EngineState&), any number of times.
+	///@par
+	///Copying the state is cheap (the cuboid planes are shared copy-on-write, see Cuboid), so a
+	///game can be forked many times to try different moves from the same position.
+	///@note Blocks point to the shapes owned by the Engine which created them, so the state can be
+	///restored only into that engine.
+	///@sa Engine::state()
+	struct EngineState
+		{
+		///Game cuboid with all the cubes saved on it.
+		Cuboid cuboid;
+		///Current block data.
+		///This is the block which is currently visible for the user.
+		///@sa next
+		Block current;
+		///Next block data.
+		///This block will take place of current, when the second one will be saved on cuboid.
+		///@sa current
+		Block next;
+		///Points counter object.
+		Points points;
+		///Random numbers generator choosing the blocks.
+		///Every engine has its own generator, so the game with the same seed always gets the same
+		///blocks (and many engines can work in many threads).
+		Random random;
+		///Creates the state of a game which hasn't started yet (with no blocks).
+		///@param size Width and height of the cuboid.
+		///@param depth Depth of the cuboid.
+		///@param seed Seed of the blocks generator.
+		EngineState(int size, int depth, boost::uint64_t seed): cuboid(size, depth), points(size), random(seed)	{}
+		};
+
+//----------------------------------------------------------------------------
+
+	///Essential data for CuTe game engine.
+	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+	///@date Jul 2005-Mar 2006
+	///@par
+	///In this class there are stored cuboid and blocks data.
+	///Some most important method are here: rotation, ability to put block in specific place,
+	///loading blocks from file, etc.
+	class Engine
+		{
+		private:
+			///Cuboid, blocks, points and blocks generator.
+			///@sa state()
+			EngineState state_;
 			///Table of Z coordinates of planes, which were removed lastly.
 			///Z coords of all Z planes which were removed are stored here. If removedPlanes[x] = true
 			///than Z plane x was removed during last call to removeFilledPlanes.
 			///Information from this array can be read by removedPlane(int z)
 			///@sa removeFilledPlanes()
 			///@sa removedPlane(int z)
+			///@sa Cuboid::removeFilledPlanes()
 			std::vector<bool> removedPlanes;
-			///Points counter object.
-			///@sa Engine::Points
-			Points points_;
-			///Current block data.
-			///This is the block which is currently visible for the user.
-			///@sa Block
-			///@sa next
-			Block current;
-			///Next block data.
-			///This block will take place of current, when the second one will be saved on cuboid.
-			///@sa current
-			Block next;
+			///Shapes of all blocks which are available for player.
+			///Loaded once in loadBlocks() together with all their orientations. Blocks used during
+			///the game only point to these objects.
+			///@sa loadBlocks()
+			///@sa blocks
+			std::vector<const BlockShape*> shapes;
 			///List of blocks which are available for player.
 			///The blocks data is loaded earlier. This list may vary depending on how difficult blocks set
 			///have the player choosen.
 			///@sa loadBlocks()
-			std::vector<const Block*> blocks;
+			std::vector<Block> blocks;
+			///Recorder of the game inputs, NULL if the game isn't recorded.
+			///@sa record()
+			boost::scoped_ptr<ReplayRecorder> recorder_;
+			///Records an input event if the game is recorded.
+			///@param code Event code, see ReplayRecorder::event().
+			///@param argument Event argument, see ReplayRecorder::event().
+			void recordEvent(int code, int argument = 0)	{if(recorder_) recorder_->event(code, argument);}
 			///Loads blocks data from the XML data source.
 			///This method loads all blocks data (sizes and position of block cubes) from external
 			///XML source (file or key).
@@ -281,21 +674,9 @@ namespace CuTe
 			void loadBlocks(int blocksSet);
 			///Returns random block from available ones
 			///@return reference to a randomly choosen block from blocks list
-			///@sa current
-			///@sa next
+			///@sa EngineState::random
 			///@sa blocks
-			const Block &getRandomBlock() const	{return *blocks[rand() % blocks.size()];}
-			///Is the specified Z plane fully filled by cubes.
-			///@param z Z plane which you want to check.
-			///@return True if specified plane is fully filled with cubes. Otherwise false.
-			///@sa removeFilledPlanes()
-			bool filledPlane(int z);
-			///Checks whether the whole cuboid is empty.
-			///This function is called when some planes were removed - after that it might happen
-			///that no cubes left on cuboid - bonus points should be added then.
-			///@return True if no cubes left on a cuboid. Otherwise false.
-			///@sa removeFilledPlanes()
-			bool empty() const;
+			const Block &getRandomBlock()	{return blocks[state_.random(blocks.size())];}
 			///Tries to put given block on a cuboid.
 			///Checks whether the given block can be put on a cuboid. If it can't, tries to move it
 			///using tryMove(). This function is called by every public rotate*() functions.
@@ -317,22 +698,26 @@ namespace CuTe
 			///however because of inivisible walls, this range is widen to <-WALL_THICKNESS; size + WALL_THICKNESS - 2>
 			///@sa size()
 			///@sa depth_
-			///@sa WALL_THICKNESS
+			///@sa Cuboid::WALL_THICKNESS
 			const int size_;
 			///Depth of a cuboid.
 			///Depth can be in range <0, depth_ - 1>, but because of invisible additional walls, this is
 			///actually <-WALL_THICKNESS, depth_ + WALL_THICKNESS - 1>
 			///@sa depth()
 			///@sa size_
-			///@sa WALL_THICKNESS
+			///@sa Cuboid::WALL_THICKNESS
 			const int depth_;
+			///Set of blocks used in the game.
+			///@sa blocksSet()
+			///@sa loadBlocks()
+			const int blocksSet_;
 		protected:
 			///Check which Z planes are filled and removes them.
 			///Method sets the removedPlanes array and moves those not filled block, which were higher
 			///filled ones.
 			///@sa removedPlanes
 			///@sa switchBlocks()
-			///@sa filledPlane(int z)
+			///@sa Cuboid::removeFilledPlanes()
 			virtual void removeFilledPlanes();
 			///Tries to move block if it is close to the walls and can't be rotated because of that.
 			///If block is too close to the wall it might happen that after rotation some cubes in a block
@@ -374,11 +759,13 @@ namespace CuTe
 			///@param difficulty Stores information about the game difficulty, which are the game cuboid
 			///size, depth and the desired blocksSet. All this information is used when creating game
 			///cuboid data.
-			Engine(const Difficulty& difficulty);
+			///@param seed Seed of the blocks generator; the same seed gives the same blocks sequence.
+			///@sa randomSeed()
+			Engine(const Difficulty& difficulty, boost::uint64_t seed = randomSeed());
 			///Destructor.
-			///Releases memory of blocks, allocated in loadBlocks()
+			///Releases memory of block shapes, allocated in loadBlocks()
 			///@sa loadBlocks()
-			virtual ~Engine()	{for_each(blocks.begin(), blocks.end(), deleter<const Block>);}
+			virtual ~Engine()	{for_each(shapes.begin(), shapes.end(), deleter<const BlockShape>);}
 			///Returns the game cuboid size.
 			///@return Size of the game cuboid.
 			///@sa size_
@@ -387,6 +774,17 @@ namespace CuTe
 			///@return Depth of the game cuboid.
 			///@sa depth_
 			int depth()	const {return depth_;}
+			///Returns the set of blocks used in the game.
+			///@return Blocks set as given in Difficulty.
+			///@sa blocksSet_
+			int blocksSet()	const {return blocksSet_;}
+			///Returns the seed the game was started with.
+			///@sa EngineState::random
+			boost::uint64_t seed() const	{return state_.random.seed();}
+			///Returns a new seed for a game which doesn't need to be repeated.
+			///Seed is taken from rand(), so it should be called only from the main thread.
+			static boost::uint64_t randomSeed()
+				{return (static_cast<boost::uint64_t>(rand()) << 32) ^ (static_cast<boost::uint64_t>(rand()) << 16) ^ rand();}
 			///Reading cuboid data.
 			///This function returns the cuboid data to environment.
 			///@param x X coordinate which of cube which we want to read. Can be in range
@@ -395,22 +793,43 @@ namespace CuTe
 			///@param z Z coordinate; Can be in range <0;depth_ - 1>
 			///@return True if on specified (x, y, z) position there is a cube. If field is empty
 			///return false
-			virtual bool operator()(int x, int y, int z) const;
+			///@sa Cuboid::operator()()
+			virtual bool operator()(int x, int y, int z) const	{return state_.cuboid(x, y, z);}
 			///Checkes whether specified Z plane was removed in last move.
 			///If removedPlane(z) = true it means that z-th plane was removed (was fully filled)
 			///in last call to moveForward()
 			///@sa removedPlanes
 			///@sa moveForward()
 			virtual bool removedPlane(int z) const	{return removedPlanes[z];}
+			///Returns the height of a cuboid column.
+			///@param x X coordinate of a column in range <0; size_)
+			///@param y Y coordinate of a column in range <0; size_)
+			///@return Z coordinate of the topmost cube in (x, y) column or -1 if the column is empty.
+			///@sa Cuboid::height()
+			int height(int x, int y) const	{return state_.cuboid.height(x, y);}
+			///Counts how far the block can be moved forward.
+			///@param block Block to check; normally it should be possible to put it on a cuboid.
+			///@return How many times block can be moved forward without collision.
+			///@sa distance()
+			///@sa Cuboid::dropDistance()
+			int dropDistance(const Block& block) const	{return state_.cuboid.dropDistance(block);}
+			///Returns the game cuboid.
+			///The cuboid can be copied to test some block placements without changing the game.
+			///@sa Cuboid
+			const Cuboid& cuboid() const	{return state_.cuboid;}
+			///Returns the list of blocks which are available for player.
+			///Every new block is chosen randomly (with equal probability) from this list.
+			///@sa blocks
+			const std::vector<Block>& allBlocks() const	{return blocks;}
 			///Returns a current block.
 			///@return const reference to a current block. Thanks to that environment can read current block data
 			///(for example for drawing) but it can't change it.
 			///@sa nextBlock()
-			virtual const Block &currentBlock() const	{return current;}
+			virtual const Block &currentBlock() const	{return state_.current;}
 			///Returns a next block.
 			///@return const reference to a next block.
 			///@sa currentBlock()
-			virtual const Block &nextBlock() const	{return next;}
+			virtual const Block &nextBlock() const	{return state_.next;}
 			///Tries to move current block left.
 			///@return True if block was moved left succesfully, otherwise (there was a collision after move)
 			///returns false.
@@ -456,10 +875,30 @@ namespace CuTe
 			virtual bool rotateZCCW();
 			///Game points counter.
 			///@return Points object reference to allow user read the points using operator int().
-			virtual Points& points() {return points_;}
+			virtual Points& points() {return state_.points;}
 			///Changes points multiplier.
 			///@sa Points::mul()
-			virtual void pointsMul(int newMul)	{points_.mul(newMul);}
+			virtual void pointsMul(int newMul)	{recordEvent(ReplayRecorder::POINTS_MUL, newMul); state_.points.mul(newMul);}
+			///Takes away some points when the player cheats.
+			///@sa Points::cheat()
+			void cheat()	{recordEvent(ReplayRecorder::CHEAT); state_.points.cheat();}
+			///Returns the whole state of the game.
+			///Copy it to save the game; copying costs nearly nothing, whatever the cuboid size.
+			///@sa state(const EngineState&)
+			const EngineState& state() const	{return state_;}
+			///Restores the game state saved earlier.
+			///Removed planes are cleared, the recorded replay (if any) doesn't include the restore.
+			///@param saved State returned by state() of this engine.
+			///@throws CuTeEx when the state has other cuboid size or depth.
+			void state(const EngineState& saved);
+			///Starts recording the game inputs.
+			///It should be called before the first move, otherwise the replay won't be the same game.
+			///@sa recorder()
+			void record()	{recorder_.reset(new ReplayRecorder(seed(), size_, depth_, blocksSet_));}
+			///Returns the recorder of the game inputs.
+			///@return Recorder or NULL if the game isn't recorded.
+			///@sa record()
+			ReplayRecorder* recorder() const	{return recorder_.get();}
 			///Checkes whether block can be put on cuboid.
 			///Very important function can be used in two situations: when player wants to rotate block
 			///(rotation is impossible if after this action block would collide with other cubes),
@@ -467,8 +906,8 @@ namespace CuTe
 			///impossible it means that block reached cubes on cuboid and should be saved on it.
 			///@param block Block which should be checked
 			///@return True if specified block can be put in the cuboid without collision
-			///@sa loadBlocks()
-			bool canPut(const Block &block) const;
+			///@sa Cuboid::canPut()
+			bool canPut(const Block &block) const	{return state_.cuboid.canPut(block);}
 	};		//class Engine
 
 //----------------------------------------------------------------------------
@@ -31,7 +31,9 @@
 #include <algorithm>
 #include <complex>
 #include <cmath>
+#include <boost/bind.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/thread/thread.hpp>
 #include "language.h"
 #include "game.h"
 using namespace CuTe;
@@ -61,7 +63,7 @@ void Game::Camera::update()
 		if(prevState == VIEW)
 			lastSolid = pos();		//save the position before pressing Ctrl or Shift
 		prevState = parent.win.keyDown(parent.controls(Controls::CAMERA_SET_PERMANENT))? EDIT_PERM : EDIT_TEMP;
-		float timeElapsed = timer.restart() / 1000.0;		//update camera position
+		float timeElapsed = timer.restartMicroseconds() / 1000000.0;		//update camera position
 		if(parent.win.keyDown(parent.controls(Controls::MOVE_UP)))
 			pos().x() += timeElapsed * ROTATION_SPEED;
 		if(parent.win.keyDown(parent.controls(Controls::MOVE_DOWN)))
@@ -157,10 +159,10 @@ void Game::Input::rotateBlockXY(int direction)
 	{
 	switch(direction)
 		{
-		case 0: parent.engine_.rotateYCCW(); break;
-		case 1: parent.engine_.rotateXCW(); break;
-		case 2: parent.engine_.rotateYCW(); break;
-		default: parent.engine_.rotateXCCW(); break;
+		case 0: parent.command(Controls::ROTATE_YCCW); break;
+		case 1: parent.command(Controls::ROTATE_XCW); break;
+		case 2: parent.command(Controls::ROTATE_YCW); break;
+		default: parent.command(Controls::ROTATE_XCCW); break;
 		}
 	}
 
@@ -168,20 +170,20 @@ void Game::Input::moveBlock(int direction)
 	{
 	switch(direction)
 		{
-		case 0: parent.engine_.moveRight(); break;
-		case 1: parent.engine_.moveUp(); break;
-		case 2: parent.engine_.moveLeft(); break;
-		default: parent.engine_.moveDown(); break;
+		case 0: parent.command(Controls::MOVE_RIGHT); break;
+		case 1: parent.command(Controls::MOVE_UP); break;
+		case 2: parent.command(Controls::MOVE_LEFT); break;
+		default: parent.command(Controls::MOVE_DOWN); break;
 		}
 	}
 
 void Game::Input::rotateBlockZ(int newWheel)
 	{
 	if(wheel > newWheel)		//wheel rotated forward
-		parent.engine_.rotateZCW();
+		parent.command(Controls::ROTATE_ZCW);
 	else
 		if(wheel < newWheel)		//wheel rotated backward
-			parent.engine_.rotateZCCW();
+			parent.command(Controls::ROTATE_ZCCW);
 	wheel = newWheel;		//save current wheel position
 	}
 
@@ -245,7 +247,7 @@ void Game::Input::mouseCheck()
 	timer.restart();
 	rotateBlockZ(parent.win.mouse().wheel);
 	if(parent.win.mouse().lButton)
-		parent.engine_.moveForward();
+		parent.command(Controls::MOVE_FORWARD);
 	}
 
 void Game::Input::keyboardCheck()
@@ -254,41 +256,63 @@ void Game::Input::keyboardCheck()
 		!parent.win.keyDown(parent.controls(Controls::CAMERA_SET_PERMANENT)))
 		{		//none of Shift and Ctrl were pressed, just move the block
 		if(parent.win.keyDown(parent.controls(Controls::MOVE_UP)))
-			parent.engine().moveUp();
+			parent.command(Controls::MOVE_UP);
 		if(parent.win.keyDown(parent.controls(Controls::MOVE_DOWN)))
-			parent.engine().moveDown();
+			parent.command(Controls::MOVE_DOWN);
 		if(parent.win.keyDown(parent.controls(Controls::MOVE_RIGHT)))
-			parent.engine().moveRight();
+			parent.command(Controls::MOVE_RIGHT);
 		if(parent.win.keyDown(parent.controls(Controls::MOVE_LEFT)))
-			parent.engine().moveLeft();
+			parent.command(Controls::MOVE_LEFT);
 		}
 	if(parent.win.keyDown(parent.controls(Controls::MOVE_FORWARD)))
-		parent.engine().moveForward();
+		parent.command(Controls::MOVE_FORWARD);
 	if(parent.win.keyDown(parent.controls(Controls::ROTATE_XCW)))		//block rotations
-		parent.engine().rotateXCW();
+		parent.command(Controls::ROTATE_XCW);
 	if(parent.win.keyDown(parent.controls(Controls::ROTATE_XCCW)))
-		parent.engine().rotateXCCW();
+		parent.command(Controls::ROTATE_XCCW);
 	if(parent.win.keyDown(parent.controls(Controls::ROTATE_YCW)))
-		parent.engine().rotateYCW();
+		parent.command(Controls::ROTATE_YCW);
 	if(parent.win.keyDown(parent.controls(Controls::ROTATE_YCCW)))
-		parent.engine().rotateYCCW();
+		parent.command(Controls::ROTATE_YCCW);
 	if(parent.win.keyDown(parent.controls(Controls::ROTATE_ZCW)))
-		parent.engine().rotateZCW();
+		parent.command(Controls::ROTATE_ZCW);
 	if(parent.win.keyDown(parent.controls(Controls::ROTATE_ZCCW)))
-		parent.engine().rotateZCCW();
-	//init cheat-class if F1 pressed and cheat class idle
-	if(parent.win.keyPressed(parent.controls(Controls::CHEAT)) && (parent.cheater.state() == BlockAnalyzer::IDLE))
+		parent.command(Controls::ROTATE_ZCCW);
+	}
+
+void Game::Input::keyPressed(int keyCode, bool repeated)
+	{
+	if(repeated || (parent.engine().frame().pauseMode != GLEngine::PauseInfo::RUNNING))
+		return;
+	const int action = parent.controls.controlAction(static_cast<unsigned char>(keyCode));
+	switch(action)
 		{
-		parent.cheater.process();		//start cheat-machine analyzer
-		parent.engine().points().cheat();		//take away some half of points
+		case Controls::MOVE_LEFT:
+		case Controls::MOVE_RIGHT:
+		case Controls::MOVE_UP:
+		case Controls::MOVE_DOWN:
+			if(parent.win.keyDown(parent.controls(Controls::CAMERA_SET_TEMPORARY)) ||
+				parent.win.keyDown(parent.controls(Controls::CAMERA_SET_PERMANENT)))
+				break;		//with Shift or Ctrl these keys move the camera
+		case Controls::MOVE_FORWARD:
+		case Controls::ROTATE_XCW:
+		case Controls::ROTATE_XCCW:
+		case Controls::ROTATE_YCW:
+		case Controls::ROTATE_YCCW:
+		case Controls::ROTATE_ZCW:
+		case Controls::ROTATE_ZCCW:
+		case Controls::CHEAT:		//the simulation thread starts the cheater only if it is idle
+			parent.command(action);
+			break;
 		}
 	}
 
 bool Game::Input::check()
 	{
-	if(parent.engine().pauseInfo.mode() == GLEngine::PauseInfo::RUNNING)		//game normally running
+	const int mode = parent.engine().frame().pauseMode;
+	if(mode == GLEngine::PauseInfo::RUNNING)		//game normally running
 		if(parent.win.keyPressed(VK_ESCAPE))
-			parent.engine().pause(true);		//pause the game
+			parent.command(PAUSE);		//pause the game
 		else		//if game still isn't paused, normally check controls
 			{
 			keyboardCheck();
@@ -296,9 +320,8 @@ bool Game::Input::check()
 				mouseCheck();
 			}
 	else		//game is paused
-		if(parent.win.keyPressed(VK_ESCAPE)
-			&& (parent.engine().pauseInfo.mode() != GLEngine::PauseInfo::GAME_OVER))
-			parent.engine().pause(false);		//resume game if pause is not caused by game over
+		if(parent.win.keyPressed(VK_ESCAPE) && (mode != GLEngine::PauseInfo::GAME_OVER))
+			parent.command(RESUME);		//resume game if pause is not caused by game over
 		else
 			if(parent.win.keyPressed(VK_RETURN))
 				return true;
@@ -396,7 +419,7 @@ const std::string Game::Controls::keyCodeToStr(unsigned char keyCode)
 	return '[' + lexical_cast<std::string>(static_cast<int>(keyCode)) + ']';
 	}
 
-int Game::Controls::controlAction(unsigned char keyCode)
+int Game::Controls::controlAction(unsigned char keyCode) const
 	{
 	int dist = std::distance(actions.begin(), std::find(actions.begin(), actions.end(), keyCode));
 	if(dist < ALL_ACTIONS)
@@ -409,8 +432,96 @@ int Game::Controls::controlAction(unsigned char keyCode)
 Game::Game(CuTeWindow &parentWindow, const Difficulty& iDifficulty, const Controls& iControls):
 	CuTeScene(parentWindow), engine_(iDifficulty, win.extensions()), controls(iControls),
 		input(*this, parentWindow.mode() > CuTeWindow::W_1024x768), done_(false),
-		camera(*this), sideBar(iDifficulty, win.extensions()), cheater(engine_, false)
+		camera(*this), sideBar(iDifficulty, win.extensions()), cheater(engine_, false),
+		simulating(false), cheating(false), failed(false)
+	{
+	}
+
+void Game::execute(int action)
+	{
+	const int mode = engine_.pauseInfo.mode();
+	switch(action)
+		{
+		case PAUSE: if(mode == GLEngine::PauseInfo::RUNNING) engine_.pause(true); return;
+		case RESUME: if(mode == GLEngine::PauseInfo::PAUSED) engine_.pause(false); return;
+		}
+	if(mode != GLEngine::PauseInfo::RUNNING)
+		return;		//the command was sent before the game got paused
+	switch(action)
+		{
+		case Controls::ROTATE_XCW: engine_.rotateXCW(); break;
+		case Controls::ROTATE_XCCW: engine_.rotateXCCW(); break;
+		case Controls::ROTATE_YCW: engine_.rotateYCW(); break;
+		case Controls::ROTATE_YCCW: engine_.rotateYCCW(); break;
+		case Controls::ROTATE_ZCW: engine_.rotateZCW(); break;
+		case Controls::ROTATE_ZCCW: engine_.rotateZCCW(); break;
+		case Controls::MOVE_LEFT: engine_.moveLeft(); break;
+		case Controls::MOVE_RIGHT: engine_.moveRight(); break;
+		case Controls::MOVE_UP: engine_.moveUp(); break;
+		case Controls::MOVE_DOWN: engine_.moveDown(); break;
+		case Controls::MOVE_FORWARD: engine_.moveForward(); break;
+		case Controls::CHEAT:
+			if(cheater.state() == BlockAnalyzer::IDLE)
+				{
+				cheater.process();		//start cheat-machine analyzer
+				engine_.cheat();		//take away some half of points
+				}
+			break;
+		}
+	}
+
+void Game::simulation()
+	{
+	try
+		{
+		const boost::int64_t tickTime = 1000000 / tickRate();
+		cheater.timeSlice(std::max(1, 500 / tickRate()));		//half a tick, so the engine keeps the pace
+		MyOGL::Timer timer;
+		boost::int64_t nextTick = 0;
+		while(simulating)
+			{
+			int action;
+			while(commands.pop(action))
+				execute(action);
+			if(cheater.state() != BlockAnalyzer::IDLE)
+				cheater.process();		//process cheating analysis if cheater is not idle
+			cheating = (cheater.state() != BlockAnalyzer::IDLE);
+			engine_.tick(1.0f / tickRate());		//simulate and publish the next frame
+			nextTick += tickTime;
+			const boost::int64_t wait = nextTick - timer.microseconds();
+			if(wait > 0)
+				boost::this_thread::sleep(boost::posix_time::microseconds(wait));
+			else
+				if(wait < -MAX_FRAME_TICKS * tickTime)
+					nextTick = timer.microseconds();		//too late to catch up, drop the lost time
+			}
+		}
+	catch(std::exception& ex)
+		{
+		error = ex.what();
+		failed = true;
+		}
+	}
+
+void Game::start()
 	{
+	simulating = true;
+	boost::thread simulationThread(boost::bind(&Game::simulation, this));
+	win.keyListener(&input);
+	try
+		{
+		CuTeScene::start();
+		}
+	catch(...)
+		{
+		win.keyListener(0);
+		simulating = false;
+		simulationThread.join();
+		throw;
+		}
+	win.keyListener(0);
+	simulating = false;
+	simulationThread.join();
 	}
 
 void Game::drawMainGame()
@@ -426,13 +537,14 @@ void Game::drawSideBar()
 	//Set the viewport to the upper part of info sidebar
 	win.viewport(win.height(), win.width(), win.height(), win.width() - win.height(), true);
 	SideBar::GameInfo info;		//save game information which will be shown on sidebar
-	info.points = engine_.points();
+	const EngineFrame& frame = engine_.frame();
+	info.points = frame.points;
 	float temp;
-	info.dist = (engine_.distance() + modf(engine_.blockPos().z(), &temp) - 0.5) / (engine_.depth() - 1);
-	info.forwardMoveTime = engine_.moveForwardTime();
-	info.speedChangeTime = engine_.speedChangeTime();
-	info.speed = engine_.speed();
-	info.gameTime = engine_.gameTime();
+	info.dist = (frame.distance + modf(engine_.blockPos().z(), &temp) - 0.5) / (engine_.depth() - 1);
+	info.forwardMoveTime = frame.moveForwardTime;
+	info.speedChangeTime = frame.speedChangeTime;
+	info.speed = frame.speed;
+	info.gameTime = frame.gameTime;
 	glDisable(GL_DEPTH_TEST);
 	sideBar.draw(info);		//pass game info to sideBar method
 	glEnable(GL_DEPTH_TEST);
@@ -448,10 +560,13 @@ void Game::drawNextBlock()
 
 void Game::refresh()
 	{
+	if(failed)
+		throw CuTeEx("Game simulation error: " + error);
 	if(input.check())
 		done();		//call run if user wants to finish the game
-	if(cheater.state() != BlockAnalyzer::IDLE)
-		cheater.process();		//process cheating analysis if cheater is not idle
+	engine_.readFrame();
+	//the frame was published at most one tick ago, interpolate towards it by its age
+	engine_.interpolate(std::min(1.0f, engine_.frameAge() * tickRate() / 1000000.0f));
 	drawMainGame();
 	drawSideBar();
 	drawNextBlock();
@@ -36,7 +36,10 @@
 
 #include <complex>
 #include <utility>
+#include <string>
 #include <boost/array.hpp>
+#include <boost/atomic.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
 #include "scene.h"
 #include "glengine.h"
 #include "sidebar.h"
@@ -55,6 +58,15 @@ namespace CuTe
 	///@par
 	///This object takes care of all the drawings, including cuboid, blocks, menus, camera, etc.
 	///It mostly uses the extended game information from EngineExt object.
+	///@par Simulation thread
+	///The game engine (and the cheater analyzer) runs in its own thread started by start(), at the
+	///fixed tickRate(). The scene thread only reads the input and draws: the user actions are sent
+	///to the simulation thread through a lock-free queue (see command()) and everything is drawn from
+	///the frames published by the engine (see GLEngine::frame()). This way a slow frame doesn't delay
+	///the automatic block moves and the long analysis doesn't stop the drawing.
+	///@note The block commands are sent straight from the key messages (see Input::keyPressed()),
+	///so a key pressed and released between two drawn frames isn't lost. The messages are dispatched
+	///by the scene thread, which stays the only producer of the queue.
 	///@sa EngineExt
 	///@todo Speed-up rendering by omitting overlapped cube walls
 	class Game: public CuTeScene
@@ -186,7 +198,9 @@ namespace CuTe
 			///@par Using
 			///All you have to do is to call the check() method every frame so that the class
 			///could check the current mouse and keyboard events events and respond for them.
-			class Input
+			///The key presses are also received straight from the window (see keyPressed()), so the
+			///short ones between two frames aren't missed.
+			class Input: public MyOGL::KeyListener
 				{
 				private:
 					///Mouse dead zone circle radius.
@@ -299,6 +313,13 @@ namespace CuTe
 					///Besides it informs whether the user wants to finish the game.
 					///@return True if user wants to finish the game.
 					bool check();
+					///Sends the block command assigned to the pressed key.
+					///Called by the window for every key press message. Auto repeated presses are skipped,
+					///the keys hold down are checked every frame by keyboardCheck() anyway. Camera keys
+					///are left to check().
+					///@param keyCode Virtual key code of the pressed key.
+					///@param repeated True if the key was already down.
+					void keyPressed(int keyCode, bool repeated);
 				};		//class Input
 
 			///Reference to game engine.
@@ -344,6 +365,48 @@ namespace CuTe
 			///Calling this function also causes taking half of the user points.
 			///@sa cheater
 			void cheat();
+			///Command pausing the game.
+			///Commands are the Controls action codes, the ones which aren't connected to any key
+			///are negative.
+			///@sa command()
+			static const int PAUSE = -1;
+			///Command resuming the paused game.
+			///@sa command()
+			static const int RESUME = -2;
+			///Maximum number of commands waiting for the simulation thread.
+			///Simulation thread takes all the commands every tick, so the queue never fills up unless
+			///the thread hangs (and then the commands are simply lost).
+			static const int COMMANDS_CAPACITY = 256;
+			///Commands sent from the scene thread to the simulation thread.
+			///@sa command()
+			boost::lockfree::spsc_queue<int, boost::lockfree::capacity<COMMANDS_CAPACITY> > commands;
+			///Simulation thread runs as long as this flag is set.
+			///@sa start()
+			boost::atomic<bool> simulating;
+			///Set by the simulation thread when the cheater is not idle.
+			///@sa animating()
+			boost::atomic<bool> cheating;
+			///Set when the simulation thread has finished with an exception.
+			///@sa error
+			boost::atomic<bool> failed;
+			///Message of the exception which finished the simulation thread.
+			///Written before setting failed, it is then thrown again by refresh().
+			std::string error;
+			///Sends a command to the simulation thread.
+			///@param action Controls action code or PAUSE or RESUME.
+			///@sa execute()
+			void command(int action)	{commands.push(action);}
+			///Executes a command in the simulation thread.
+			///Block moves and rotations sent before the game was paused are ignored.
+			///@param action Controls action code or PAUSE or RESUME.
+			///@sa command()
+			void execute(int action);
+			///Simulation thread routine.
+			///Executes the commands, processes the cheater and ticks the engine tickRate() times per second
+			///until simulating is cleared. The cheater gets half a tick per loop (see
+			///BlockAnalyzer::timeSlice()), so analysing doesn't slow the automatic moves down.
+			///@sa start()
+			void simulation();
 		public:
 
 			///Stores the virtual key codes for all common game actions.
@@ -541,7 +604,7 @@ namespace CuTe
 					///@return -1 if the specified key isn't assigned to any customizable action. Otherwise
 					///returns this action code.
 					///@throws CuTeEx when the action parameter is not valid.
-					int controlAction(unsigned char keyCode);
+					int controlAction(unsigned char keyCode) const;
 					///Overloaded assignment operator.
 					///Pleas note that this operator copies only the key codes. It does not change the
 					///controlsKey pointer value.
@@ -564,8 +627,23 @@ namespace CuTe
 			///All OpenGL code goes here. In this method the OpenGL scene is drawn onto the buffer and
 			///the screen is refreshed.
 			void refresh();
+			///Plays the game.
+			///Starts the simulation thread, runs the scene and stops the thread when the scene is done.
+			///@sa simulation()
+			void start();
+			///Tells whether the game screen changes without any input.
+			///When the game is paused or overed nothing moves (apart from the pause message, which can
+			///stand still), unless the cheater is still analyzing.
+			bool animating()
+				{return (engine_.frame().pauseMode == GLEngine::PauseInfo::RUNNING) || cheating;}
+			///Pauses the game when the window is deactivated.
+			///The simulation thread doesn't look at the window, without pausing it would go on playing
+			///while the game can't be seen.
+			void deactivated()	{command(PAUSE);}
 			///Returns game engine associated with object.
 			///Some environment routines must call EngineExt methods explicitly.
+			///@note While start() is running, the engine is used by the simulation thread, read
+			///GLEngine::frame() then.
 			///@return Reference to an EngineExt object.
 			///@sa engine() const
 			///@sa EngineExt
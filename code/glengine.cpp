@@ -39,6 +39,23 @@ using namespace std;
 
 //----------------------------------------------------------------------------
 
+EngineFrame::EngineFrame(int size, int depth):
+	cuboid(size, depth), removedPlanes(depth, false), planesShift(depth, 0.0), planesAlpha(-1.0), switches(0),
+		blockAlpha(0.0), grid(new std::list<Line>), points(0), distance(0), speed(0), gameTime(0),
+		moveForwardTime(0.0), speedChangeTime(0.0), pauseMode(0), time(0)
+	{
+	}
+
+const Point<float, 3> EngineFrame::blockPos(float alpha) const
+	{
+	//the last step is not done fully until the next tick
+	const Point<float, 3> shift = posShift - posStep * (1.0f - alpha);
+	return Point<float, 3>(current.pos().x() + shift.x() + 0.5,
+		current.pos().y() + shift.y() + 0.5, current.pos().z() + shift.z() + 0.5);
+	}
+
+//----------------------------------------------------------------------------
+
 const float EngineExt::MOVE_SPEED = 8.0;
 const float EngineExt::ROTATION_SPEED = 540.0;
 const float EngineExt::MOVE_FORWARD_SPEED = 10.0;
@@ -48,11 +65,12 @@ const float EngineExt::MAXIMAL_ALPHA = 1.0;
 const float EngineExt::BLOCK_BLEND_SPEED = 1.5;
 const float EngineExt::PLANES_BLEND_SPEED = 3.0;
 
-EngineExt::EngineExt(const Difficulty& difficulty):
-	Engine(difficulty), ALPHA_COEFF(log(MINIMAL_ALPHA / MAXIMAL_ALPHA) / difficulty.depth()),
-		blockAlpha_(MINIMAL_ALPHA), blockAlphaShift(0.0), cuboidPlanesShift(difficulty.depth(), 0.0),
-		removingPlanes(false), speed_(0), moveForwardPeriod(MOVE_FORWARD_PERIOD_MAX),
-		speedChangePeriod(randomSpeedChangePeriod())
+EngineExt::EngineExt(const Difficulty& difficulty, boost::uint64_t seed):
+	Engine(difficulty, seed), speedRandom(seed + 1), speedChangePeriod(randomSpeedChangePeriod()),
+		ALPHA_COEFF(log(MINIMAL_ALPHA / MAXIMAL_ALPHA) / difficulty.depth()), blockAlpha_(MINIMAL_ALPHA),
+		blockAlphaShift(0.0), cuboidPlanesShift(difficulty.depth(), 0.0), speedChangeClock(0.0),
+		moveForwardClock(0.0), gameClock(0.0), removingPlanes(false), speed_(0),
+		moveForwardPeriod(MOVE_FORWARD_PERIOD_MAX)
 	{
 	generateBlockGrid();		//generate grid for the first block
 	}
@@ -92,7 +110,7 @@ bool EngineExt::moveForward()
 	if(!removingPlanes && (posShift.z() <= 0.0) && Engine::moveForward())
 		{
 		posShift.z() = 1.0;
-		moveForwardTimer.restart();		//reset the timer only when the moving actually taken place
+		moveForwardClock = 0.0;		//reset the clock only when the moving actually taken place
 		return true;
 		}
 	return false;
@@ -175,14 +193,15 @@ void EngineExt::switchBlocks()
 	Engine::switchBlocks();
 	generateBlockGrid();		//generate line grid for the new current block
 	posShift.z() = 3.0;		//move block closer the user a bit
+	posStep = Point<float, 3>();		//new block, nothing to interpolate
 	blockAlpha_ = MINIMAL_ALPHA;		//alpha value should change rapidly here (don't use smooth shift)
 	}
 
-void EngineExt::update()
+void EngineExt::update(float tau)
 	{
-	updateTimes();
-	//tau is the time which have elapsed since last update();
-	const float tau = timer.restart() / 1000.0;
+	updateTimes(tau);
+	const Point<float, 3> oldPosShift = posShift;
+	const Point<float, 3> oldAngleShift = angleShift;
 	decAbs(posShift.x(), tau * MOVE_SPEED);
 	decAbs(posShift.y(), tau * MOVE_SPEED);
 	decAbs(posShift.z(), tau * MOVE_FORWARD_SPEED);		//moving forward with different speed
@@ -200,11 +219,38 @@ void EngineExt::update()
 	decAbs<float>(angleShift, angle);
 	///Change the blend speed
 	decAbs<float>(blockAlphaShift, tau * BLOCK_BLEND_SPEED);
+	updateBlockAlpha();
+	posStep = posShift - oldPosShift;		//remember the steps for drawing between the updates
+	angleStep = angleShift - oldAngleShift;
+	}
+
+void EngineExt::snapshot(EngineFrame& frame)
+	{
+	frame.cuboid = cuboid();		//planes are shared until the engine changes them
+	for(int z = 0; z < depth(); ++z)
+		frame.removedPlanes[z] = removedPlane(z);
+	frame.planesShift = cuboidPlanesShift;
+	frame.planesAlpha = planesAlpha();
+	frame.current = currentBlock();
+	frame.next = nextBlock();
+	frame.posShift = posShift;
+	frame.posStep = posStep;
+	frame.angleShift = angleShift;
+	frame.angleStep = angleStep;
+	frame.blockAlpha = blockAlpha();
+	frame.grid = grid_;
+	frame.points = points();
+	frame.distance = distance();
+	frame.speed = speed();
+	frame.gameTime = gameTime();
+	frame.moveForwardTime = moveForwardTime();
+	frame.speedChangeTime = speedChangeTime();
 	}
 
 void EngineExt::generateBlockGrid()
 	{
-	grid_.clear();		//erases prevoius grid data
+	std::list<Line>* grid = new std::list<Line>;
+	grid_.reset(grid);		//the previous grid may be still drawn from some frame
 	//each field of ?lines (? - x, y or z) corresponds to one line parallel to ? axis
 	bool xlines[6][6][6] = {false};
 	bool ylines[6][6][6] = {false};
@@ -234,15 +280,15 @@ void EngineExt::generateBlockGrid()
 			for(z = 0; z < 6; ++z)
 				{		//converts 3 3D arrays into line coordinates
 				if(xlines[x][y][z])
-					grid_.push_back(Line(
+					grid->push_back(Line(
 						Point<double, 3>(x - 2.5, y - 2.5, z - 2.5),
 						Point<double, 3>(x - 1.5, y - 2.5, z - 2.5)));
 				if(ylines[x][y][z])
-					grid_.push_back(Line(
+					grid->push_back(Line(
 						Point<double, 3>(x - 2.5, y - 1.5, z - 2.5),
 						Point<double, 3>(x - 2.5, y - 2.5, z - 2.5)));
 				if(zlines[x][y][z])
-					grid_.push_back(Line(
+					grid->push_back(Line(
 						Point<double, 3>(x - 2.5, y - 2.5, z - 1.5),
 						Point<double, 3>(x - 2.5, y - 2.5, z - 2.5)));
 				}
@@ -263,14 +309,13 @@ bool EngineExt::tryMove(Block &block)
 	return false;
 	}
 
-float EngineExt::blockAlpha()
+void EngineExt::updateBlockAlpha()
 	{
 	const float newAlpha = MAXIMAL_ALPHA * exp(ALPHA_COEFF * (distance() + posShift.z()));
 	//Is the difference between previous and current alpha too big?
 	if(abs(blockAlpha_ + blockAlphaShift - newAlpha) > 0.03)
 		blockAlphaShift += blockAlpha_ - newAlpha;		//if it is, set shifts so that it could change smoothly
 	blockAlpha_ = newAlpha;
-	return blockAlpha_ + blockAlphaShift;
 	}
 
 float EngineExt::planesAlpha() const
@@ -281,12 +326,6 @@ float EngineExt::planesAlpha() const
 		return -1.0;		//to be sure that this will be noticed, -1.0 is returned insted of 0.0
 	}
 
-const Point<float, 3> EngineExt::blockPos() const
-	{
-	return Point<float, 3>(currentBlock().pos().x() + posShift.x() + 0.5,
-		currentBlock().pos().y() + posShift.y() + 0.5, currentBlock().pos().z() + posShift.z() + 0.5);
-	}
-
 void EngineExt::removeFilledPlanes()
 	{
 	Engine::removeFilledPlanes();		//call base class method - physically remove planes
@@ -312,18 +351,21 @@ void EngineExt::increaseSpeed()
 		{		//9th speed is the fastest
 		++speed_;
 		moveForwardPeriod = MOVE_FORWARD_PERIOD_MAX * exp(COEFF * speed_);
-		speedChangeTimer.restart();		//restart time to next speed change
+		speedChangeClock = 0.0;		//restart time to next speed change
 		pointsMul(speed_ + 1);		//increase points multiplier
 		speedChangePeriod = randomSpeedChangePeriod();
 		}
 	}
 
-void EngineExt::updateTimes()
+void EngineExt::updateTimes(float tau)
 	{
-	if(moveForwardTimer >= moveForwardPeriod)
+	speedChangeClock += tau * 1000.0;
+	moveForwardClock += tau * 1000.0;
+	gameClock += tau * 1000.0;
+	if(moveForwardClock >= moveForwardPeriod)
 		//more time elapsed than FORWARD_MOVE_PERIOD - block should be moved forward automatically
 		moveForward();
-	if(speedChangeTimer >= speedChangePeriod)
+	if(speedChangeClock >= speedChangePeriod)
 		increaseSpeed();
 	}
 
@@ -331,32 +373,14 @@ float EngineExt::speedChangeTime() const
 	{
 	if(speed_ == 9)
 		return 1.0;		//if it's the fastest level, don't show this timer value
-	return static_cast<float>(SPEED_CHANGE_PERIOD - speedChangeTimer) / SPEED_CHANGE_PERIOD;
+	return static_cast<float>((SPEED_CHANGE_PERIOD - speedChangeClock) / SPEED_CHANGE_PERIOD);
 	}
 
 float EngineExt::moveForwardTime() const
 	{
 	if(speed_ == 9)
 		return 0.0;
-	return static_cast<float>(moveForwardPeriod - moveForwardTimer) / moveForwardPeriod;
-	}
-
-void EngineExt::pause(bool pauseState)
-	{
-	if(pauseState)
-		{		//pause all game timers
-		timer.pause();
-		speedChangeTimer.pause();
-		moveForwardTimer.pause();
-		gameTimer.pause();
-		}
-	else
-		{		//resume all game timers
-		timer.resume();
-		speedChangeTimer.resume();
-		moveForwardTimer.resume();
-		gameTimer.resume();
-		}
+	return static_cast<float>((moveForwardPeriod - moveForwardClock) / moveForwardPeriod);
 	}
 
 //----------------------------------------------------------------------------
@@ -370,7 +394,7 @@ GLEngine::Walls::Walls(int size, int depth, double border):
 
 void GLEngine::Walls::update()
 	{
-	const float diff = COLOR_CHANGE_SPEED * timer.restart() / 1000.0;
+	const float diff = COLOR_CHANGE_SPEED * timer.restartMicroseconds() / 1000000.0;
 	color += diff;
 	while(color >= 2 * M_PI)
 		color -= 2 * M_PI;
@@ -379,33 +403,46 @@ void GLEngine::Walls::update()
 		phi -= 2 * M_PI;
 	}
 
-void GLEngine::Walls::draw()
+void GLEngine::Walls::addPoint(int x, int y, int z, const float rgb[3])
+	{
+	Renderer::ColorVertex point;
+	for(int i = 0; i < 3; ++i)
+		point.color[i] = static_cast<unsigned char>(min(rgb[i], 1.0f) * 255);		//value may be above 1.0
+	point.color[3] = 255;
+	point.x = x;
+	point.y = y;
+	point.z = z;
+	points.push_back(point);
+	}
+
+void GLEngine::Walls::draw(Renderer& renderer)
 	{
 	update();
-	glPushMatrix();
-	glScalef(BORDER, BORDER, BORDER);
+	points.clear();
+	float rgb[3];
 	int x, y, z;
-	glBegin(GL_POINTS);
-	glColorHSV(color, 0.6, 0.6 + 0.45 * (sin(phi) + 1));
+	MyOGL::hsv2rgb(color, 0.6f, 0.6f + 0.45f * (sin(phi) + 1), rgb);
 	for(x = 1; x < SIZE; ++x)
 		for(y = 1; y < SIZE; ++y)
-			glVertex2i(x, y);
+			addPoint(x, y, 0, rgb);
 	for(z = 0; z <= DEPTH; ++z)
 		{
-		glColorHSV(color, 0.6, 0.6 + 0.45 * (sin(phi + z / 4.0) + 1));
+		MyOGL::hsv2rgb(color, 0.6f, 0.6f + 0.45f * (sin(phi + z / 4.0f) + 1), rgb);
 		for(x = 0; x <= SIZE; ++x)
 			{
-			glVertex3i(x, 0, z);
-			glVertex3i(x, SIZE, z);
+			addPoint(x, 0, z, rgb);
+			addPoint(x, SIZE, z, rgb);
 			}
 		for(y = 1; y <= SIZE; ++y)
 			{
-			glVertex3i(0, y, z);
-			glVertex3i(SIZE, y, z);
+			addPoint(0, y, z, rgb);
+			addPoint(SIZE, y, z, rgb);
 			}
 		}
-	glEnd();
-	glPopMatrix();
+	renderer.pushMatrix();
+	renderer.scale(BORDER, BORDER, BORDER);
+	renderer.draw(Renderer::POINTS, Renderer::C4UB_V3F, &points[0], static_cast<int>(points.size()));
+	renderer.popMatrix();
 	}
 
 //----------------------------------------------------------------------------
@@ -419,26 +456,26 @@ GLEngine::PauseInfo::PauseInfo(MyOGL::Extensions& iExtensions):
 	{
 	}
 
-void GLEngine::PauseInfo::draw()
+void GLEngine::PauseInfo::draw(int mode)
 	{
 	update();
 	glDisable(GL_DEPTH_TEST);
-	drawMsg();
-	drawHelp();
+	drawMsg(mode);
+	drawHelp(mode);
 	glEnable(GL_DEPTH_TEST);
 	}
 
 void GLEngine::PauseInfo::update()
 	{
-	angle += timer.restart() / 1000.0 * ROTATION_SPEED;
+	angle += timer.restartMicroseconds() / 1000000.0 * ROTATION_SPEED;
 	}
 
-void GLEngine::PauseInfo::drawMsg()
+void GLEngine::PauseInfo::drawMsg(int mode)
 	{
 	glLoadIdentity();
 	glTranslatef(0.0, 0.0, -7.0);
 	glColorHSV(angle / 5.0, 1.0, 0.4);
-	if(mode() == PAUSED)
+	if(mode == PAUSED)
 		{
 		glRotatef(sin(angle) * MSG_AMPL, 0.0, 0.0, 1.0);
 		glTranslatef(-extensions.outlineFonts().width(PAUSE_MSG) / 2, -0.22, 0.0);
@@ -452,76 +489,105 @@ void GLEngine::PauseInfo::drawMsg()
 		}
 	}
 
-void GLEngine::PauseInfo::drawHelp()
+void GLEngine::PauseInfo::drawHelp(int mode)
 	{
 	glColorHSV(2 * M_PI / 3, 0.3, 0.7);
-	if(mode_ == PAUSED)		//don't display info about resume when game is over
+	if(mode == PAUSED)		//don't display info about resume when game is over
 		extensions.bitmapFonts().pos(-0.2, -0.9) << langData["inGame"]["esc"].value();
 	extensions.bitmapFonts().pos(-0.241, -0.98) << langData["inGame"]["enter"].value();
 	}
 
 //----------------------------------------------------------------------------
 
-GLEngine::GLEngine(const Difficulty& difficulty, MyOGL::Extensions& iExtensions):
-	EngineExt(difficulty), pauseInfo(iExtensions), extensions(iExtensions),
-		walls(difficulty.size(), difficulty.depth(), 4.0 / size()), border(4.0 / size()),
-		cubeDisplayList(buildDisplayLists()), nextBlockPreview(*this)
+GLEngine::GLEngine(const Difficulty& difficulty, MyOGL::Extensions& iExtensions, boost::uint64_t seed):
+	EngineExt(difficulty, seed), pauseInfo(iExtensions), extensions(iExtensions),
+		renderer(iExtensions), walls(difficulty.size(), difficulty.depth(), 4.0 / size()), border(4.0 / size()),
+		cuboidView(difficulty.size() >= GREEDY_MESH_SIZE),
+		frames(EngineFrame(difficulty.size(), difficulty.depth())),
+		frameAlpha(1.0), switches(0), nextBlockPreview(*this)
+	{
+	publish();		//first frame, so that there is something to draw before the first tick
+	readFrame();
+	}
+
+GLEngine::~GLEngine()
+	{
+	cuboidView.release(renderer);
+	}
+
+void GLEngine::tick(float tau)
 	{
+	if(pauseInfo.mode() == PauseInfo::RUNNING)
+		update(tau);
+	publish();
 	}
 
-void GLEngine::drawCuboid() const
+void GLEngine::publish()
 	{
-	glEnable(GL_BLEND);
+	EngineFrame& frame = frames.back();
+	snapshot(frame);
+	frame.previousNext = previousNext;
+	frame.switches = switches;
+	frame.pauseMode = pauseInfo.mode();
+	frame.time = clock.microseconds();
+	frames.publish();
+	}
+
+void GLEngine::drawCuboid()
+	{
+	const EngineFrame& frame = this->frame();
+	renderer.enable(Renderer::BLEND);
+	cuboidView.draw(renderer, frame.cuboid, frame.planesShift, border);
 	int x, y, z;
 	for(z = 0; z < depth(); ++z)
-		{
-		glColorHSV(ZPlanePos(z) * M_PI / 3, 1.0, 1.0);
-		for(y = 0; y < size(); ++y)
-			for(x = 0; x < size(); ++x)
-				if(operator()(x, y, z))		//use overloaded operator operator()
-					drawCube(x + 0.5, y + 0.5, ZPlanePos(z) + 0.5, border);
-		}
-	for(z = 0; z < depth(); ++z)
-		if(removedPlane(z) && planesAlpha() > 0.0)
-			{
-			glColorHSV(z * M_PI / 3, 1.0, 1.0, planesAlpha());
+		if(frame.removedPlanes[z] && frame.planesAlpha > 0.0)
 			for(y = 0; y < size(); ++y)
 				for(x = 0; x < size(); ++x)
-					drawCube(x + 0.5, y + 0.5, z + 0.5, border);
-			}
-	glDisable(GL_BLEND);
+					addCube(x + 0.5, y + 0.5, z + 0.5, border, z * M_PI / 3, 1.0, 1.0, frame.planesAlpha);
+	drawCubes();		//all the removed planes at once
+	renderer.disable(Renderer::BLEND);
 	}
 
 void GLEngine::drawBlock()
 	{
-	glEnable(GL_BLEND);
-	glPushMatrix();		//save cuboid position
-	glTranslated(blockPos().x() * border, blockPos().y() * border, blockPos().z() * border);
-	glRotated(blockAngles().x(), 1.0, 0.0, 0.0);
-	glRotated(blockAngles().y(), 0.0, 1.0, 0.0);
-	glRotated(blockAngles().z(), 0.0, 0.0, 1.0);
-	alpha = blockAlpha();
+	renderer.enable(Renderer::BLEND);
+	renderer.pushMatrix();		//save cuboid position
+	const Point<float, 3> pos = blockPos();
+	const Point<float, 3> angles = blockAngles();
+	renderer.translate(pos.x() * border, pos.y() * border, pos.z() * border);
+	renderer.rotate(angles.x(), 1.0, 0.0, 0.0);
+	renderer.rotate(angles.y(), 0.0, 1.0, 0.0);
+	renderer.rotate(angles.z(), 0.0, 0.0, 1.0);
+	alpha = frame().blockAlpha;
 	drawBlockGrid();
 	drawBlockCubes();
-	glPopMatrix();
-	glDisable(GL_BLEND);
+	renderer.popMatrix();
+	renderer.disable(Renderer::BLEND);
 	}
 
-///@todo use CuTeScene::drawCube() here insted
 void GLEngine::drawBlockCubes()
 	{
-	const int range = currentBlock().range();
+	const Block& block = frame().current;
+	const int range = block.range();
 	float phi = blockPos().z() - 0.5;		//hue in radians
 	while(phi >= 6.0)
 	phi -= 6.0;		//trim z to a range <0;6)
 	for(int z = -range; z <= range; ++z)
 		for(int y = -range; y <= range; ++y)
 			for(int x = -range; x <= range; ++x)
-				if(currentBlock()(x, y, z))
-					{
-					glColorHSV((phi + z) * M_PI / 3, 1.0, 1.0, alpha);
-					drawCube(x, y, z, border);
-					}
+				if(block(x, y, z))
+					addCube(x, y, z, border, (phi + z) * M_PI / 3, 1.0, 1.0, alpha);
+	drawCubes();
+	}
+
+///Converts an end of a grid line to a vertex.
+static Renderer::PosVertex gridVertex(const Point<double, 3>& point)
+	{
+	Renderer::PosVertex vertex;
+	vertex.x = point.x();
+	vertex.y = point.y();
+	vertex.z = point.z();
+	return vertex;
 	}
 
 ///@bug Something's wrong in this function, when blocks goes down very fast (not smooth anim.)
@@ -530,101 +596,78 @@ void GLEngine::drawBlockGrid()
 	//Grid alpha is decreasing proportionally to alpha increeasing. But when alpha is greater than
 	//DELTA, grid alpha is set to 0.0 (it's not even drawn)
 	static const float DELTA = 0.8;
-	if(alpha < DELTA)		//is the grid alpha greater than 0.0?
+	if(alpha < DELTA && !frame().grid->empty())		//is the grid alpha greater than 0.0?
 		{
+		gridLines.clear();
+		for(std::list<Line>::const_iterator line = frame().grid->begin(); line != frame().grid->end(); ++line)
+			{
+			gridLines.push_back(gridVertex(line->first));
+			gridLines.push_back(gridVertex(line->second));
+			}
 		//the more opaque cube walls, the darker grid
-		glColorHSV(0.0, 0.0, 0.7 * (1 - alpha / DELTA));
-		glPushMatrix();
-		glScalef(border, border, border);
-		glBegin(GL_LINES);
-		for_each(grid().begin(), grid().end(), drawBlockGridLine);
-		glEnd();
-		glPopMatrix();
+		renderer.colorHSV(0.0, 0.0, 0.7 * (1 - alpha / DELTA));
+		renderer.pushMatrix();
+		renderer.scale(border, border, border);
+		renderer.draw(Renderer::LINES, Renderer::V3F, &gridLines[0], static_cast<int>(gridLines.size()));
+		renderer.popMatrix();
 		}
 	}
 
-void GLEngine::drawCube(double x, double y, double z, double border) const
+void GLEngine::addCube(float x, float y, float z, float border, float hue, float saturation, float value,
+	float alpha)
 	{
-	extensions.textures().enable();
-	extensions.textures().select(0);		//select cube texture
-	glPushMatrix();		//saves current position
-	glTranslatef(x * border, y * border, z * border);
-	border *= 0.99;		//make a cube a little bit smaller
-	glScaled(border, border, border);
-	glCallList(cubeDisplayList);
-	glPopMatrix();
-	extensions.textures().disable();
+	float rgb[3];
+	MyOGL::hsv2rgb(hue, saturation, value, rgb);
+	//cube is a little bit smaller than the distance between the cubes
+	cubes.add(x * border, y * border, z * border, border * CuboidMesh::CUBE_SIZE, rgb, alpha);
+	}
+
+void GLEngine::drawCubes()
+	{
+	if(!cubes.empty())
+		{
+		const std::vector<CubeBatch::Vertex>& vertices = cubes.vertices();
+		renderer.enable(Renderer::TEXTURE);
+		renderer.texture(0);		//select cube texture
+		renderer.draw(Renderer::QUADS, Renderer::T2F_C4UB_V3F, &vertices[0], static_cast<int>(vertices.size()));
+		renderer.disable(Renderer::TEXTURE);
+		}
+	cubes.clear();
 	}
 
 void GLEngine::draw()
 	{
-	walls.draw();
-	switch(pauseInfo.mode())
+	walls.draw(renderer);
+	switch(frame().pauseMode)
 		{
 		case PauseInfo::RUNNING:
 			drawCuboid();
 			drawBlock();
-			update();		//update EngineExt data after redrawing
 			break;
 		case PauseInfo::GAME_OVER:
 			drawCuboid();
 			drawBlock();
 		case PauseInfo::PAUSED:
-			pauseInfo.draw();
+			pauseInfo.draw(frame().pauseMode);
 		}
 	}
 
-GLuint GLEngine::buildDisplayLists()
-	{
-	GLuint dList = glGenLists(1);
-	glNewList(dList, GL_COMPILE);
-	glBegin(GL_QUADS);
-	glTexCoord2i(0, 0); glVertex3d(-0.5, -0.5, -0.5);		//Back surface of a cube
-	glTexCoord2i(1, 0); glVertex3d(0.5, -0.5, -0.5);
-	glTexCoord2i(1, 1); glVertex3d(0.5, 0.5, -0.5);
-	glTexCoord2i(0, 1); glVertex3d(-0.5, 0.5, -0.5);
-	glTexCoord2i(0, 0); glVertex3d(-0.5, 0.5, -0.5);		//Left surface
-	glTexCoord2i(1, 0); glVertex3d(-0.5, -0.5, -0.5);
-	glTexCoord2i(1, 1); glVertex3d(-0.5, -0.5, 0.5);
-	glTexCoord2i(0, 1); glVertex3d(-0.5, 0.5, 0.5);
-	glTexCoord2i(0, 0); glVertex3d(0.5, -0.5, 0.5);		//Right surface
-	glTexCoord2i(1, 0); glVertex3d(0.5, -0.5, -0.5);
-	glTexCoord2i(1, 1); glVertex3d(0.5, 0.5, -0.5);
-	glTexCoord2i(0, 1); glVertex3d(0.5, 0.5, 0.5);
-	glTexCoord2i(0, 0); glVertex3d(-0.5, -0.5, -0.5); //Bottom surface
-	glTexCoord2i(1, 0); glVertex3d(0.5, -0.5, -0.5);
-	glTexCoord2i(1, 1); glVertex3d(0.5, -0.5, 0.5);
-	glTexCoord2i(0, 1); glVertex3d(-0.5, -0.5, 0.5);
-	glTexCoord2i(0, 0); glVertex3d(-0.5, 0.5, -0.5);		//Top surface
-	glTexCoord2i(1, 0); glVertex3d(-0.5, 0.5, 0.5);
-	glTexCoord2i(1, 1); glVertex3d(0.5, 0.5, 0.5);
-	glTexCoord2i(0, 1); glVertex3d(0.5, 0.5, -0.5);
-	glTexCoord2i(0, 0); glVertex3d(-0.5, -0.5, 0.5);		//Front surface of a cube
-	glTexCoord2i(1, 0); glVertex3d(0.5, -0.5, 0.5);
-	glTexCoord2i(1, 1); glVertex3d(0.5, 0.5, 0.5);
-	glTexCoord2i(0, 1); glVertex3d(-0.5, 0.5, 0.5);
-	glEnd();
-	glEndList();
-	return dList;
-	}
-
 void GLEngine::switchBlocks()
 	{
 	sounds.play(Sounds::SWITCH_BLOCKS);
 	EngineExt::switchBlocks();
-	nextBlockPreview.switchBlocks();
+	previousNext = currentBlock();
+	++switches;
 	}
 
 void GLEngine::pause(bool pauseState)
 	{
-	EngineExt::pause(pauseState);
 	pauseInfo.mode(pauseState? PauseInfo::PAUSED : PauseInfo::RUNNING);
 	}
 
 void GLEngine::gameOver()
 	{
-	EngineExt::gameOver();
-	pauseInfo.mode(PauseInfo::GAME_OVER);
+	pauseInfo.mode(PauseInfo::GAME_OVER);		//stops the animations and game clocks
 	sounds.play(Sounds::GAME_OVER);
 	}
 
@@ -637,29 +680,30 @@ const float GLEngine::NextBlockPreview::BEAT_MIN = 0.5;
 const float GLEngine::NextBlockPreview::BEAT_MAX = 0.55;
 
 GLEngine::NextBlockPreview::NextBlockPreview(GLEngine &iParent):
-	parent(iParent), angle(0.0), color(0.0), alphaShift(0.0), beat(BEAT_PERIOD)
+	parent(iParent), angle(0.0), color(0.0), alphaShift(0.0), beat(BEAT_PERIOD), switches(0)
 	{
 	}
 
 void GLEngine::NextBlockPreview::draw()
 	{
 	update();
-	glRotatef(35.0, 1.0, 0.0, 0.0);
-	glRotatef(angle, 0.0, -1.0, 0.0);
-	const int range = max(parent.nextBlock().range(), previousBlock.range());
+	Renderer& renderer = parent.renderer;
+	renderer.rotate(35.0, 1.0, 0.0, 0.0);
+	renderer.rotate(angle, 0.0, -1.0, 0.0);
+	const Block& nextBlock = parent.frame().next;
+	const int range = max(nextBlock.range(), previousBlock.range());
 	const float border = BEAT_MIN + (BEAT_MAX - BEAT_MIN) *
 		(exp(-512.0 * sqr(beat - (BEAT_PERIOD - BEAT_PEAK_INTERVAL) / 2)) +
 		exp(-512.0 * sqr(beat - (BEAT_PERIOD + BEAT_PEAK_INTERVAL) / 2)));
-	glEnable(GL_BLEND);
-	glEnable(GL_FOG);
-	glFogf(GL_FOG_START, 2.0);
-	glFogf(GL_FOG_END, 4.5);
+	renderer.enable(Renderer::BLEND);
+	renderer.enable(Renderer::FOG);
+	renderer.fog(2.0, 4.5);
 	for(int y = -range; y <= range; ++y)
 		for(int z = -range; z <= range; ++z)
 			for(int x = -range; x <= range; ++x)
 				{
 				float alpha = 0.0;		//current block alpha value
-				if(parent.nextBlock()(x, y, z))
+				if(nextBlock(x, y, z))
 					if(previousBlock(x, y, z))
 						alpha = 1.0;
 					else
@@ -668,18 +712,16 @@ void GLEngine::NextBlockPreview::draw()
 					if(previousBlock(x, y, z))
 						alpha = alphaShift;
 				if(alpha > 0.0)
-					{
-					glColorHSV(color, 0.8, 0.8, alpha);
-					parent.drawCube(x, y, z, border);
-					}
+					parent.addCube(x, y, z, border, color, 0.8, 0.8, alpha);
 				}
-	glDisable(GL_FOG);
-	glDisable(GL_BLEND);
+	parent.drawCubes();
+	renderer.disable(Renderer::FOG);
+	renderer.disable(Renderer::BLEND);
 	}
 
 void GLEngine::NextBlockPreview::update()
 	{
-	const float tau = timer.restart() / 1000.0;
+	const float tau = timer.restartMicroseconds() / 1000000.0;
 	angle += tau * 90.0;		//rotate block
 	color += tau * 0.1;		//change the color a bit
 	if(color >= 2 * M_PI)
@@ -688,12 +730,12 @@ void GLEngine::NextBlockPreview::update()
 	decAbs(beat, tau);
 	if(beat == 0.0)
 		beat = BEAT_PERIOD;
-	}
-
-void GLEngine::NextBlockPreview::switchBlocks()
-	{
-	alphaShift = 1.0;
-	previousBlock = parent.currentBlock();
+	if(parent.frame().switches != switches)
+		{		//blocks were switched, blend the new next block in
+		switches = parent.frame().switches;
+		alphaShift = 1.0;
+		previousBlock = parent.frame().previousNext;
+		}
 	}
 
 //----------------------------------------------------------------------------
@@ -721,7 +763,7 @@ void GLEngine::Camera::update()
 	trimAngle(shift.y());
 
 	//The COEFF makes camera move more smooth and simultanous.
-	float timeElapsed = timer.restart() / 1000.0;
+	float timeElapsed = timer.restartMicroseconds() / 1000000.0;
 	const float COEFF = max3(abs(shift.x() / speed_), abs(shift.y() / speed_), 
 		abs(shift.z() / speed_));
 	if(COEFF > 0.0)		//if this is 0.0, camera isn't on its solid position, should go back to it
@@ -36,8 +36,13 @@
 //----------------------------------------------------------------------------
 
 #include <list>
+#include <boost/shared_ptr.hpp>
 #include "MyOGL/window.h"
 #include "engine.h"
+#include "cuboidview.h"
+#include "cubebatch.h"
+#include "glrenderer.h"
+#include "triplebuffer.h"
 
 //----------------------------------------------------------------------------
 
@@ -51,6 +56,93 @@ namespace CuTe
 	///@sa Game::grid
 	typedef std::pair<Point<double, 3>, Point<double, 3> > Line;
 
+//----------------------------------------------------------------------------
+
+	///Everything needed to draw the game, taken from the engine at one moment.
+	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+	///@date Jul 2005-Mar 2006
+	///@par
+	///The game engine may be simulated in its own thread (see Game), so the drawing code can't
+	///read the engine directly. After every tick the engine state is copied into an EngineFrame
+	///which is then published using TripleBuffer (see GLEngine::tick()) and never changed again.
+	///Copying is cheap: the cuboid planes and the block grid are shared, not copied.
+	struct EngineFrame
+		{
+		///Game cuboid with all the cubes saved on it.
+		Cuboid cuboid;
+		///Planes removed by the last moveForward().
+		///@sa Engine::removedPlane()
+		std::vector<bool> removedPlanes;
+		///Z shifts of the planes moving down after some planes were removed.
+		///@sa ZPlanePos()
+		std::vector<double> planesShift;
+		///Alpha value of the removed planes, negative when no planes are being removed.
+		///@sa EngineExt::planesAlpha()
+		float planesAlpha;
+		///Current block.
+		Block current;
+		///Next block.
+		Block next;
+		///Next block which was previewed before the last blocks switch (it became the current one).
+		///@sa switches
+		Block previousNext;
+		///Number of blocks switches so far, changes every time the blocks were switched.
+		///@sa GLEngine::NextBlockPreview
+		int switches;
+		///Current block floating point position shift.
+		///@sa blockPos()
+		Point<float, 3> posShift;
+		///Change of posShift in the last tick.
+		///@sa blockPos()
+		Point<float, 3> posStep;
+		///Current block angle shifts.
+		///@sa blockAngles()
+		Point<float, 3> angleShift;
+		///Change of angleShift in the last tick.
+		///@sa blockAngles()
+		Point<float, 3> angleStep;
+		///Current block alpha value.
+		///@sa EngineExt::blockAlpha()
+		float blockAlpha;
+		///Border lines of the current block.
+		///@sa EngineExt::generateBlockGrid()
+		boost::shared_ptr<const std::list<Line> > grid;
+		///Points count.
+		int points;
+		///Distance between the current block and the cuboid.
+		int distance;
+		///Game speed level.
+		int speed;
+		///Game time in 1/10 second.
+		int gameTime;
+		///Time left to the next automatic forward move, see EngineExt::moveForwardTime().
+		float moveForwardTime;
+		///Time left to the next speed level, see EngineExt::speedChangeTime().
+		float speedChangeTime;
+		///Pause mode, see GLEngine::PauseInfo.
+		int pauseMode;
+		///Time when the frame was published in us, see GLEngine::frameAge().
+		boost::int64_t time;
+		///Creates an empty frame.
+		///@param size Width and height of the cuboid.
+		///@param depth Depth of the cuboid.
+		EngineFrame(int size, int depth);
+		///Returns current block position.
+		///@param alpha Position of the drawn frame between the previous and this tick (see
+		///MyOGL::Scene::tickAlpha()).
+		///@return Floating point position of the middle point of the current block.
+		const Point<float, 3> blockPos(float alpha) const;
+		///Returns current block angles.
+		///@param alpha Position of the drawn frame between the previous and this tick.
+		///@return X, Y and Z floating point angle shifts of the current block.
+		const Point<float, 3> blockAngles(float alpha) const	{return angleShift - angleStep * (1.0f - alpha);}
+		///Returns floating-point position of a specified Z plane.
+		///Z planes are moving only when they are removed (see EngineExt::removeFilledPlanes()).
+		///@param z Number of planes which position we want to gain.
+		///@return Position of Zth plane.
+		double ZPlanePos(int z) const {return z + planesShift[z];}
+		};
+
 //----------------------------------------------------------------------------
 
 	///Floating point wrap for main game engine.
@@ -122,6 +214,12 @@ namespace CuTe
 			///@sa SPEED_CHANGE_PERIOD
 			///@sa increaseSpeed()
 			static const int SPEED_CHANGE_VARIATION = static_cast<int>(SPEED_CHANGE_PERIOD * 0.2);
+			///Random numbers generator for speedChangePeriod.
+			///Started with the seed following the engine one, so that the blocks sequence doesn't
+			///depend on speed changes.
+			///@note Declared before speedChangePeriod, which is initialized with it.
+			///@sa Engine::seed()
+			Random speedRandom;
 			///Time to next speed change for the current speed level.
 			///This value is generated randomly for every level.
 			///@sa randomSpeedChangePeriod()
@@ -132,8 +230,8 @@ namespace CuTe
 			///@sa speedChangePeriod
 			///@sa SPEED_CHANGE_PERIOD
 			///@sa SPEED_CHANGE_VARIATION.
-			static int randomSpeedChangePeriod()
-				{return static_cast<int>(SPEED_CHANGE_PERIOD + SPEED_CHANGE_VARIATION * ((rand() % 1024) / 512.0 - 1));}
+			int randomSpeedChangePeriod()
+				{return static_cast<int>(SPEED_CHANGE_PERIOD + SPEED_CHANGE_VARIATION * (speedRandom(1024) / 512.0 - 1));}
 			///Period of time between two automatic block forward moves at speed 0.
 			///If the user doesn't push the forward button for a while, block is pushed forward automatically.
 			///How often ot happens, in depednds on this and @ref MOVE_FORWARD_PERIOD_MIN values.
@@ -196,33 +294,38 @@ namespace CuTe
 			///This table stores their Z shift position (individually for every plane) so that the move
 			///is goes smooth.
 			std::vector<double> cuboidPlanesShift;
-			///Game timer.
-			///It is used when calculating shifts of movements and rotations.
-			///@sa update()
-			MyOGL::Timer timer;
-			///Speed changing timer.
-			///This timer stores the time which have elapsed since last speed level change.
-			///It is reseted every time it exceed SPEED_CHANGE_PERIOD
+			///Change of posShift in the last update() call.
+			///@sa blockPos()
+			Point<float, 3> posStep;
+			///Change of angleShift in the last update() call.
+			///@sa blockAngles()
+			Point<float, 3> angleStep;
+			///Speed changing clock.
+			///Game time (in ms) which have elapsed since last speed level change. Like all the game
+			///clocks, it is advanced by update() with the tick time only, so it stops when the engine is
+			///not ticked (paused game, inactive window) and doesn't depend on the real time.
+			///It is reseted every time it exceed speedChangePeriod
 			///@sa SPEED_CHANGE_PERIOD
 			///@sa updateTimes()
-			MyOGL::Timer speedChangeTimer;
-			///Auto moving forward timer.
-			///This timer stores the time which have elapsed since last moving the block
+			double speedChangeClock;
+			///Auto moving forward clock.
+			///Game time (in ms) which have elapsed since last moving the block
 			///forward was performed (no matter if it was done by the player or automatically).
 			///If this time exceed moveForwardPeriod, block is moved forward automatically (which
-			///causes reseting this timer too).
-			MyOGL::Timer moveForwardTimer;
-			///Whole game time.
-			///This timer stores the time how long the current game is running.
+			///causes reseting this clock too).
+			double moveForwardClock;
+			///Whole game time (in ms).
 			///@sa gameTime();
-			MyOGL::Timer gameTimer;
+			double gameClock;
 			///The current block is drawn in two phases: grid borders and textured walls. The first phase
 			///requires to create a set of line which corresponds to every block edge. This job is done
 			///by generateBlockGrid() and those lines coordinates are stored in this list.
+			///A new list is created for every block (rather than changing the old one), so the published
+			///frames can share it.
 			///@sa generateBlockGrid()
 			///@sa Line
-			///@sa grid()
-			std::list<Line> grid_;
+			///@sa EngineFrame::grid
+			boost::shared_ptr<const std::list<Line> > grid_;
 			///Smart grid generation.
 			///This function generates a set of border grid coordinates on a base of current block cubes.
 			///@sa grid_
@@ -253,6 +356,10 @@ namespace CuTe
 			///This can be a value between 0 and 9, where 0 is the slowest and 9 is the fastest.
 			///@sa increaseSpeed() for more details about game speed
 			int speed_;
+			///Updates the alpha value for the current block.
+			///The alpha is counted in base of current distance() value, but it changes smoothly.
+			///@sa blockAlpha()
+			void updateBlockAlpha();
 			///Time after which the block moves forward automatically.
 			///When the time since last moving forward the block exceed this value, block will be moved
 			///forward automatically.
@@ -261,13 +368,15 @@ namespace CuTe
 			///time. And the lower this value - the tougher the game.
 			int moveForwardPeriod;
 			///Updates game times.
-			///This method checks the speedChangeTimer and moveForwardTimer and if they exceed their
+			///This method advances the game clocks by a tick time and if speedChangeClock and
+			///moveForwardClock exceed their
 			///maximum values (adequately SPEED_CHANGE_PERIOD and moveForwardPeriod), they are reseted and
 			///additional tasks are done (see those timers detailed information).
 			///@sa update()
 			///@sa moveForwardPeriod
 			///@sa speedChangePeriod
-			void updateTimes();
+			///@param tau Tick time in seconds.
+			void updateTimes(float tau);
 			///Increases speed level.
 			///When speedChangePeriod exceeds SPEED_CHANGE_PERIOD and we are not in the last (9) speed level
 			///the level is increased. This means that the time interval moveForwardPeriod will be
@@ -292,27 +401,18 @@ namespace CuTe
 			///Sets up new shifts for currentBlock so that in next frame it will move
 			///and rotate a bit (of course only if it was during rotation or movement).
 			///Besides checks the game speed timers using updateTimes().
+			///@param tau Time step in seconds; it is the same in every call (see MyOGL::Scene::tick()).
 			///@sa updateTimes()
-			virtual void update();
-			///Returns current block grid.
-			///@return Reference to a list of line coordinates - needed by the environment to
-			///draw the block grid.
-			///@sa grid
-			///@sa generateBlockGrid()
-			///@sa Game::drawBlockGrid()
-			const std::list<Line> &grid() const	{return grid_;}
-			///Overriden Engine::pause() method.
-			///When the game is overed, all block animations should be freezed. This is done by calling
-			///pause() method in this function.
-			void gameOver()	{pause(true);}
+			virtual void update(float tau);
 		public:
 			///Constructor.
 			///Creates Engine object with specified size and depth.
 			///@param difficulty Stores information about the game difficulty, which are the game cuboid
 			///size, depth and the desired blocksSet. All this information is used when creating game
 			///cuboid in Engine object.
+			///@param seed Seed of the blocks generator, see Engine::Engine().
 			///@sa Engine::Engine()
-			EngineExt(const Difficulty& difficulty);
+			EngineExt(const Difficulty& difficulty, boost::uint64_t seed = randomSeed());
 			///Moves block right if it is possible.
 			///@return Always true. Pleas note that the return value is left only because of compatibility
 			///with base class Engine::moveRight() version. In derived class version this boolean return
@@ -379,28 +479,15 @@ namespace CuTe
 			///value is useless.
 			///@sa Engine::rotateZCCW() for more details.
 			bool rotateZCCW();
-			///Returns current block position.
-			///@return Floating point position of a current block. It is the position of a middle
-			///point in a block
-			///@sa blockAngles()
-			const Point<float, 3> blockPos() const;
-			///Returns current block angles.
-			///@return X, Y and Z floating point angle shifts of a current block.
-			///@sa blockPos()
-			const Point<float, 3> &blockAngles() const {return angleShift;}
-			///Returns floating-point position of a specified Z plane.
-			///Z planes are moving only when they are removed (see @ref removeFilledPlanes()).
-			///During this process to correcly draw the cuboid in GLEngine, environment must now
-			///the exact position of all planes (though the zth plane position is always integral z).
-			///@param z Number of planes which position we want to gain.
-			///@return Position of Zth plane.
-			double ZPlanePos(int z)	const {return z + cuboidPlanesShift[z];}
+			///Copies the engine state needed for drawing into a frame.
+			///@param frame Frame to fill, see GLEngine::tick().
+			void snapshot(EngineFrame& frame);
 			///Returns the alpha value for the current block.
 			///The alpha is counted in base of current distance() value. It is used by
-			///Game::drawBlock()
+			///GLEngine::drawBlock()
 			///@return Alpha value in range of <0.0, 1.0>
 			///@sa blockAlpha_
-			float blockAlpha();
+			float blockAlpha() const	{return blockAlpha_ + blockAlphaShift;}
 			///Returns the alpha value of translucent removing planes.
 			///When planes are removed from cuboid, their alpha value changes from completly opaque
 			///to completly transparent. You can check this alpha from this function.
@@ -418,16 +505,11 @@ namespace CuTe
 			int speed() const	{return speed_;}
 			///Returns whole game time.
 			///@return How much time did the current time is running in 1/10 second (100 ms)
-			int gameTime() const	{return gameTimer / 100;}
+			int gameTime() const	{return static_cast<int>(gameClock / 100);}
 			///Returns the distance between the current block and cuboid.
 			///This value is represented on a progress bar in side bar, so it must be available public.
 			///@sa Engine::distance()
 			int distance()	{return Engine::distance();}
-			///Pauses the engine object.
-			///Pauses or resumes all the timers collected in this object. This causes freezing or resuming
-			///all blocks animations.
-			///@param pauseState True if you want to pause the engine, false to resume
-			virtual void pause(bool pauseState);
 		};		//class EngineExt: public Engine
 
 //----------------------------------------------------------------------------
@@ -473,6 +555,11 @@ namespace CuTe
 					///Used to calculate the next color.
 					///@sa update()
 					MyOGL::Timer timer;
+					///Points of the walls, all drawn at once.
+					///Kept between the frames so that the memory is allocated only once.
+					std::vector<Renderer::ColorVertex> points;
+					///Adds a point to the walls.
+					void addPoint(int x, int y, int z, const float rgb[3]);
 					///Updates all walls data (currently only color).
 					///@sa timer.
 					void update();
@@ -483,8 +570,9 @@ namespace CuTe
 					///Draws the walls.
 					///All you have to do from parent class is to call this method. Everything rest is done
 					///automatically (including call to update()).
+					///@param renderer Renderer to draw with.
 					///@sa update()
-					void draw();
+					void draw(Renderer& renderer);
 				};
 
 			///Manages preview of a next block.
@@ -559,6 +647,11 @@ namespace CuTe
 					///@sa update()
 					///@sa draw()
 					float beat;
+					///Number of blocks switches seen by the preview.
+					///When the drawn frame has different EngineFrame::switches, the blocks were switched
+					///and the new next block starts blending in.
+					///@sa update()
+					int switches;
 				public:
 					///Constructor.
 					NextBlockPreview(GLEngine &iParent);
@@ -566,32 +659,61 @@ namespace CuTe
 					///@note It does not change any viewport settings, this method only draws the next block.
 					///All the GL perspective and viewport jobs has to be done earilier.
 					void draw();
-					///Next block was changed.
-					///This method should be done every time the blocks are switched 'cause it must
-					///perform some additional tasks after that.
-					void switchBlocks();
 				};
 
+			///Renderer all the cubes, walls and grids are drawn with.
+			GLRenderer renderer;
 			///Object controlling walls of game cuboid.
 			///To see what features has this object, check its detailed description.
 			Walls walls;
 			///Length of a border in a single cube.
 			///This length depends on how big the game size is: the bigger size, the smaller cubes.
 			const double border;
-			///Pointer to a cube display list.
-			///OpenGL style pointer to a display list containing textured cube. Used to draw blocks,
-			///cuboid, etc.
-			///@sa drawBlock()
-			///@sa drawCuboid()
-			const GLuint cubeDisplayList;
+			///Cubes of the current drawing pass.
+			///@sa addCube()
+			///@sa drawCubes()
+			CubeBatch cubes;
+			///Smallest cuboid size drawn with greedy meshing.
+			///Cuboids up to the original maximum size of 12 are drawn cube by cube.
+			///@sa CuboidMesh
+			static const int GREEDY_MESH_SIZE = 13;
+			///Cubes saved on the cuboid, updated from the drawn frame in drawCuboid().
+			CuboidView cuboidView;
+			///Lines of the current block grid.
+			///Kept between the frames so that the memory is allocated only once.
+			///@sa drawBlockGrid()
+			std::vector<Renderer::PosVertex> gridLines;
 			///Current block alpha value.
 			///@sa EngineExt::blockAlpha
 			float alpha;
+			///Frames published by tick() for drawing.
+			///tick() may be called from other thread than draw(), so everything is drawn from the
+			///frame taken by readFrame(), never from the engine itself.
+			///@sa frame()
+			TripleBuffer<EngineFrame> frames;
+			///Position of the drawn frame between the previous and its tick.
+			///@sa interpolate()
+			float frameAlpha;
+			///Next block before the last switchBlocks().
+			///@sa EngineFrame::previousNext
+			Block previousNext;
+			///Number of blocks switches so far.
+			///@sa EngineFrame::switches
+			int switches;
+			///Clock for the frames times.
+			///@sa frameAge()
+			MyOGL::Timer clock;
+			///Fills the back frame and publishes it.
+			///@sa tick()
+			void publish();
 			///Draws the cubes which were already saved on the cuboid.
 			///This method draws only the cubes which are saved in game engine (not those, which are
 			///building the current block).
+			///The cubes are drawn by cuboidView, with one texture bind and one mesh (display list) draw
+			///for every Z plane. Only the changed planes are built again, moving planes are drawn by
+			///moving their meshes.
 			///@sa drawGrid()
-			void drawCuboid() const;
+			void drawCuboid();
 			///Draws current block.
 			///It calls directly a set of help methods to fully draw the current block. Before drawing all
 			///parts of a current block, sets up position and angle shifts.
@@ -604,33 +726,27 @@ namespace CuTe
 			///@sa drawBlock()
 			void drawBlockCubes();
 			///Draws current block grid.
-			///Draws all the lines (using @ref drawBlockGridLine()) of a cuboid grid. Uses the list of them
-			///created in EngineExt object and returned by its method EngineExt::grid().
-			///@sa drawBlockGridLine()
-			///@sa EngineExt::grid()
+			///Draws all the lines of a cuboid grid at once. Uses the list of them created in EngineExt
+			///object and published in the drawn frame.
+			///@sa gridLines
+			///@sa EngineFrame::grid
 			void drawBlockGrid();
-			///Draws one line from given Line object.
-			///Puts two points in OpenGL environment, which coordinates are stored in Line object.
-			///For performance reasons this function does not call glBegin() and glEnd() - you must take
-			///care of it by your self (it is done in drawBlockGrid(), which internally uses this method).
-			///@param line Line coordinates to be drawn
-			///@sa Line
-			///@sa drawBlockGrid()
-			static void drawBlockGridLine(const Line &line)	{glVertex3d(line.first.x(), line.first.y(), line.first.z()); glVertex3d(line.second.x(), line.second.y(), line.second.z());}
-			///Draw a cuboid of any size in any place.
-			///This method is more complex then its overloaded version drawCube(int x, int y, int z)
-			///because it gives the ability to put the cube on every place (not limited to integer
-			///coordinates) and any size.
-			///@param x X coordinate of the middle of a cube
-			///@param y Y coordinate of the middle of a cube
-			///@param z Z coordinate of the middle of a cube
+			///Adds a cube to the current drawing pass.
+			///Cube can be put on every place (not limited to integer coordinates) and have any size.
+			///Nothing is drawn until drawCubes() is called.
+			///@param x X coordinate of the middle of a cube, in borders.
+			///@param y Y coordinate of the middle of a cube, in borders.
+			///@param z Z coordinate of the middle of a cube, in borders.
 			///@param border Size of a cube (length of its border)
-			void drawCube(double x, double y, double z, double border) const;
-			///Creates OpenGL display lists.
-			///Creates OpenGL textured cube display list
-			///@return OpenGL pointer to a display list.
-			///@sa cubeDisplayList;
-			GLuint buildDisplayLists();
+			///@param hue Color hue, see MyOGL::hsv2rgb().
+			///@param saturation Color saturation.
+			///@param value Color value.
+			///@param alpha Color alpha.
+			void addCube(float x, float y, float z, float border, float hue, float saturation, float value,
+				float alpha);
+			///Draws all the cubes added since the last call at once.
+			///@sa cubes
+			void drawCubes();
 			///Object responsible for previewing next block.
 			///This object handles all the job of preview the next block.
 			///@sa NextBlockPreview for more details.
@@ -642,9 +758,9 @@ namespace CuTe
 			///@sa MyOGL::Extensions
 			MyOGL::Extensions& extensions;
 			///Some additional routines when the blocks are switched.
-			///Except calling base class method calls NextBlockPreview::switchBlocks() which
-			///must be called every time the blocks are switched.
-			///@sa NextBlockPreview::switchBlocks()
+			///Except calling base class method counts the switches, so that NextBlockPreview
+			///knows when to change the block.
+			///@sa EngineFrame::switches
 			void switchBlocks();
 			///Overriden Engine::gameOver()'s method run automatically by Engine.
 			///When the game is overed, Engine object call its pure virtual function gameOver().
@@ -696,14 +812,17 @@ namespace CuTe
 					///Current info message angle around Z axis.
 					float angle;
 					///Draws info message.
+					///@param mode Pause mode of the drawn frame.
 					///@sa PAUSE_MSG
-					void drawMsg();
+					void drawMsg(int mode);
 					///Draws simple help in pause mode.
 					///Show the information how to resume and exit the game at the bottom of the screen.
-					void drawHelp();
+					///@param mode Pause mode of the drawn frame.
+					void drawHelp(int mode);
 					///Pause flag.
 					///If it is set, it means that the game is currently paused, if not - it is normally running.
-					///This flag is read in Game::draw() to determine what object to use to draw.
+					///This flag is read in GLEngine::tick() to determine whether to simulate the game. The
+					///drawing code uses the mode from the drawn frame (EngineFrame::pauseMode) instead.
 					///@sa Game::draw()
 					///@sa RUNNING;
 					///@sa PAUSED;
@@ -729,10 +848,11 @@ namespace CuTe
 					PauseInfo(MyOGL::Extensions& iExtensions);
 					///Draws the pause screen.
 					///First calls update(), then show the info message and simple help.
+					///@param mode Pause mode of the drawn frame.
 					///@sa update()
 					///@sa drawMsg()
 					///@sa drawHelp()
-					void draw();
+					void draw(int mode);
 					///Changes the current pause mode.
 					///@param pauseMode Desired new pause mode
 					///@sa mode_ for modes list
@@ -842,12 +962,47 @@ namespace CuTe
 			///All this information is used when creating game
 			///@param iExtensions Although the object doesn't need the whole Game or even
 			///MyOGL::Window reference, because it draws the scene, it must have access to loaded extensions.
-			GLEngine(const Difficulty& difficulty, MyOGL::Extensions& iExtensions);
+			///@param seed Seed of the blocks generator, see Engine::Engine().
+			GLEngine(const Difficulty& difficulty, MyOGL::Extensions& iExtensions, boost::uint64_t seed = randomSeed());
+			///Destructor.
+			///Deletes the cuboid chunks display lists.
+			~GLEngine();
 			///Draws the whole main game panel.
 			///Very important method - it draws the whole client window including cuboid, walls, block, etc.
+			///Everything is drawn from frame(), call readFrame() before.
 			///@sa drawCuboid()
 			///@sa drawBlock()
+			///@sa tick()
 			void draw();
+			///Simulates a single time step of the game, unless the game is paused.
+			///After that the frame with the new state is published for drawing, so tick() can be called
+			///from other thread than draw() (but all the engine methods must be called from that thread
+			///too).
+			///@param tau Time step in seconds, see MyOGL::Scene::tick().
+			///@sa readFrame()
+			void tick(float tau);
+			///Takes the latest frame published by tick() for drawing.
+			///@return True if a new frame was published since the last call.
+			///@sa frame()
+			bool readFrame()	{return frames.update();}
+			///Returns the frame which is drawn.
+			///Use it rather than the engine to read the game state in the drawing thread.
+			///@sa readFrame()
+			const EngineFrame& frame() const	{return frames.front();}
+			///Sets the position of the drawn frame between the previous and its tick.
+			///@param alpha Interpolation factor, see MyOGL::Scene::tickAlpha().
+			void interpolate(float alpha)	{frameAlpha = alpha;}
+			///Returns how old the drawn frame is.
+			///@return Time since the frame was published in us.
+			boost::int64_t frameAge() const	{return clock.microseconds() - frame().time;}
+			///Returns the drawn current block position.
+			///@return Middle point of the current block, interpolated between the last two ticks.
+			///@sa EngineFrame::blockPos()
+			const Point<float, 3> blockPos() const	{return frame().blockPos(frameAlpha);}
+			///Returns the drawn current block angles.
+			///@return Angle shifts of the current block, interpolated between the last two ticks.
+			///@sa EngineFrame::blockAngles()
+			const Point<float, 3> blockAngles() const	{return frame().blockAngles(frameAlpha);}
 			///Draws next blokck preview.
 			///Because the next block preview is viewed in a different viewport, this task can't be joint
 			///into draw(). Between drawing main panel and next block preview the viewport must be
@@ -857,8 +1012,8 @@ namespace CuTe
 			///@sa PauseInfo class for more details.
 			PauseInfo pauseInfo;
 			///Pauses the GL engine.
-			///Call base class pause() method to freeze the timers and ssets the PauseInfo mode for
-			///proper pause mode displaying.
+			///Sets the PauseInfo mode for proper pause mode displaying. The game clocks are frozen
+			///because tick() doesn't update the engine unless it is running.
 			void pause(bool pauseState);
 		};		//class GLEngine: public EngineExt
 
@@ -0,0 +1,88 @@
+//----------------------------------------------------------------------------
+
+///@file
+///GLRenderer class definitions.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include "glrenderer.h"
+using namespace CuTe;
+
+//----------------------------------------------------------------------------
+
+namespace
+	{
+	///OpenGL primitive of every Renderer::Primitive.
+	const GLenum PRIMITIVES[] = {GL_POINTS, GL_LINES, GL_LINE_STRIP, GL_LINE_LOOP, GL_TRIANGLE_STRIP, GL_QUADS};
+	///OpenGL interleaved array format of every Renderer::Format.
+	const GLenum FORMATS[] = {GL_V3F, GL_C4UB_V3F, GL_T2F_V3F, GL_T2F_C4UB_V3F};
+	}
+
+//----------------------------------------------------------------------------
+
+void GLRenderer::enable(Capability capability)
+	{
+	switch(capability)
+		{
+		case BLEND: glEnable(GL_BLEND); break;
+		case FOG: glEnable(GL_FOG); break;
+		case TEXTURE: extensions.textures().enable(); break;
+		}
+	}
+
+void GLRenderer::disable(Capability capability)
+	{
+	switch(capability)
+		{
+		case BLEND: glDisable(GL_BLEND); break;
+		case FOG: glDisable(GL_FOG); break;
+		case TEXTURE: extensions.textures().disable(); break;
+		}
+	}
+
+void GLRenderer::fog(float start, float end)
+	{
+	glFogf(GL_FOG_START, start);
+	glFogf(GL_FOG_END, end);
+	}
+
+void GLRenderer::draw(Primitive primitive, Format format, const void* vertices, int count)
+	{
+	glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+	glInterleavedArrays(FORMATS[format], vertexSize(format), vertices);
+	glDrawArrays(PRIMITIVES[primitive], 0, count);
+	glPopClientAttrib();
+	}
+
+int GLRenderer::createMesh(Primitive primitive, Format format, const void* vertices, int count)
+	{
+	const GLuint list = glGenLists(1);
+	glNewList(list, GL_COMPILE);		//vertices are copied into the list
+	draw(primitive, format, vertices, count);
+	glEndList();
+	return list;
+	}
+
+//----------------------------------------------------------------------------
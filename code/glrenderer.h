@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------
+
+///@file
+///GLRenderer class declaration.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#ifndef GLRENDERER_H
+#define GLRENDERER_H
+
+//----------------------------------------------------------------------------
+
+#include "MyOGL/extensions.h"
+#include "render.h"
+
+//----------------------------------------------------------------------------
+
+namespace CuTe
+	{
+
+//----------------------------------------------------------------------------
+
+	///Renderer which draws with OpenGL.
+	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+	///@date Jul 2005-Mar 2006
+	///@par
+	///Every command is a call (or a few calls) to OpenGL in the current context. Vertex arrays are
+	///drawn with glInterleavedArrays() and glDrawArrays(), meshes are display lists.
+	class GLRenderer: public Renderer
+		{
+		private:
+			///Reference to MyOGL::Extensions, used to enable and select textures.
+			MyOGL::Extensions& extensions;
+		public:
+			///Creates a renderer drawing in the window of given extensions.
+			explicit GLRenderer(MyOGL::Extensions& iExtensions): extensions(iExtensions)	{}
+			void loadIdentity()	{glLoadIdentity();}
+			void pushMatrix()	{glPushMatrix();}
+			void popMatrix()	{glPopMatrix();}
+			void translate(float x, float y, float z)	{glTranslatef(x, y, z);}
+			void scale(float x, float y, float z)	{glScalef(x, y, z);}
+			void rotate(float angle, float x, float y, float z)	{glRotatef(angle, x, y, z);}
+			void enable(Capability capability);
+			void disable(Capability capability);
+			void texture(int index)	{extensions.textures().select(index);}
+			void fog(float start, float end);
+			void color(float red, float green, float blue, float alpha = 1.0)	{glColor4f(red, green, blue, alpha);}
+			void draw(Primitive primitive, Format format, const void* vertices, int count);
+			int createMesh(Primitive primitive, Format format, const void* vertices, int count);
+			void drawMesh(int mesh)	{glCallList(mesh);}
+			void deleteMesh(int mesh)	{glDeleteLists(mesh, 1);}
+		};		//class GLRenderer
+
+//----------------------------------------------------------------------------
+
+	}		//namespace CuTe
+
+//----------------------------------------------------------------------------
+
+#endif
+
+//----------------------------------------------------------------------------
@@ -34,7 +34,6 @@
 #include "MyXML/myxml.h"
 #include "common.h"
 using namespace CuTe;
-using MyOGL::glColorHSV;
 
 //----------------------------------------------------------------------------
 
@@ -54,26 +53,26 @@ bool Intro::keyPressed()
 
 void Intro::refresh()
 	{
-	glLoadIdentity();
-	glEnable(GL_BLEND);
-	win.extensions().textures().enable();
-	win.extensions().textures().select(0);
-	glTranslatef(0.0, 0.0, -25.0);
+	renderer().loadIdentity();
+	renderer().enable(Renderer::BLEND);
+	renderer().enable(Renderer::TEXTURE);
+	renderer().texture(0);
+	renderer().translate(0.0, 0.0, -25.0);
 	if(loadingScreen)
 		{
-		glRotatef(30.0, -1.2, 0.5, 0.3);
-		glColorHSV(2.0, 0.8, 1.0);
+		renderer().rotate(30.0, -1.2, 0.5, 0.3);
+		renderer().colorHSV(2.0, 0.8, 1.0);
 		drawCube(0.0, 0.0, 0.0, 5.0);
 		done();
-		win.extensions().textures().disable();
-		glDisable(GL_BLEND);
+		renderer().disable(Renderer::TEXTURE);
+		renderer().disable(Renderer::BLEND);
 		return;
 		}
 	if(keyPressed())
 		loadingScreen = true;
 	else
 		{
-		glRotatef(20.0, 0.3, 0.2, 0.6);
+		renderer().rotate(20.0, 0.3, 0.2, 0.6);
 		animation->draw();
 		}
 	if(animation->done())
@@ -87,8 +86,8 @@ void Intro::refresh()
 			case PHASE_EXPLODING: loadingScreen = true; break;		//finish the scene
 			}
 		}
-	win.extensions().textures().disable();
-	glDisable(GL_BLEND);
+	renderer().disable(Renderer::TEXTURE);
+	renderer().disable(Renderer::BLEND);
 	}
 
 //----------------------------------------------------------------------------
@@ -119,9 +118,9 @@ void Intro::BumpingCube::draw()
 			pos.y() = 2 * BOTTOM - pos.y();
 			}
 		}
-	glColorHSV(0.0, 0.6, 1.0);
-	glTranslatef(pos.x(), pos.y(), pos.z());
-	glRotatef(timer * 360.0 / BUMPING_TIME, rotAxis.x(), 0.0, rotAxis.y());
+	scene.renderer().colorHSV(0.0, 0.6, 1.0);
+	scene.renderer().translate(pos.x(), pos.y(), pos.z());
+	scene.renderer().rotate(timer * 360.0 / BUMPING_TIME, rotAxis.x(), 0.0, rotAxis.y());
 	scene.drawCube(0.0, 0.0, 0.0);
 	}
 
@@ -155,7 +154,7 @@ void Intro::LogoBlending::draw()
 	for(LogoCubes::const_iterator i = cubes.begin(); i != cubes.end(); ++i)
 		if(timer >= i->initTime)
 			{
-			glColorHSV((timer - i->initTime) * Cube::ALPHA_SPEED, 0.6, 1.0, (timer - i->initTime) * Cube::ALPHA_SPEED);
+			scene.renderer().colorHSV((timer - i->initTime) * Cube::ALPHA_SPEED, 0.6, 1.0, (timer - i->initTime) * Cube::ALPHA_SPEED);
 			scene.drawCube(i->pos.x(), i->pos.y(), i->pos.z());
 			}
 	}
@@ -166,10 +165,10 @@ const double Intro::LogoShaking::SHAKING_FREQ = 5.0;
 
 void Intro::LogoShaking::draw()
 	{
-	glTranslatef(0.0, 0.0, sqr(timer / 10000.0) * sin(2 * M_PI * SHAKING_FREQ * timer / 1000.0));
+	scene.renderer().translate(0.0, 0.0, sqr(timer / 10000.0) * sin(2 * M_PI * SHAKING_FREQ * timer / 1000.0));
 	for(LogoCubes::const_iterator i = cubes.begin(); i != cubes.end(); ++i)
 		{
-		glColorHSV((timer - i->initTime) * Cube::ALPHA_SPEED, 0.6, 1.0);
+		scene.renderer().colorHSV((timer - i->initTime) * Cube::ALPHA_SPEED, 0.6, 1.0);
 		scene.drawCube(i->pos);
 		}
 	}
@@ -181,11 +180,11 @@ const double Intro::LogoExploding::ROTATION_SPEED = 60.0;
 
 void Intro::LogoExploding::draw()
 	{
-	glRotatef(ROTATION_SPEED / 1000.0 * timer, -2.0, 1.0, 0.0);
+	scene.renderer().rotate(ROTATION_SPEED / 1000.0 * timer, -2.0, 1.0, 0.0);
 	for(LogoCubes::iterator i = cubes.begin(); i != cubes.end(); ++i)
 		{
 		i->pos *= 1.0 + EXPLODING_SPEED * (timer - lastTimer);
-		glColorHSV((timer - i->initTime) * Cube::ALPHA_SPEED, 0.6, 1.0);
+		scene.renderer().colorHSV((timer - i->initTime) * Cube::ALPHA_SPEED, 0.6, 1.0);
 		scene.drawCube(i->pos.x(), i->pos.y(), i->pos.z());
 		}
 	lastTimer = timer;
@@ -44,12 +44,12 @@ namespace CuTe
 //----------------------------------------------------------------------------
 
 	///Declaration of a langData variable.
-	///This variable is defined in the main.cpp file. It stores all the messages displayed in the
+	///This variable is defined in the language.cpp file. It stores all the messages displayed in the
 	///game allowing to introduce multiple languages to the game.
 	extern MyXML::Key langData;
 
 	///Definition of a langInfo variable.
-	///This variable is defined in the main.cpp file. It stores the language additional information
+	///This variable is defined in the language.cpp file. It stores the language additional information
 	///like language pack author, fonts, etc.
 	extern MyXML::Key langInfo;
 
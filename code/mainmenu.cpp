@@ -78,7 +78,7 @@ void MainMenu::NewGameItem::draw(bool isCurrent)
 void MainMenu::NewGameItem::update(bool isCurrent)
 	{
 	MenuTextItem::update(isCurrent);
-	decAbs<float>(xShift, timer.restart() / 1000.0 * HS_PANEL_X_SPEED);
+	decAbs<float>(xShift, timer.restartMicroseconds() / 1000000.0 * HS_PANEL_X_SPEED);
 	}
 
 //----------------------------------------------------------------------------
@@ -89,8 +89,9 @@ const float MainMenu::HelpItem::MOVE_AMPLITUDE = 0.3;
 MainMenu::HelpItem::HelpItem(MyOGL::Extensions& extensions, const MyXML::Key& helpItemModel,
 	const Game::Controls& iControls):
 	MenuTextItem(extensions, langData["mainMenu"]["help"]), rot(0.0),
-		modelList(buildDisplayList(helpItemModel)), controls(iControls)
+		renderer(extensions), controls(iControls)
 	{
+	model.build(renderer, helpItemModel);
 	MyXML::KeysRange items = langData["mainMenu"].keys("helpSubItem");
 	for(MyXML::KeyIterator i = items.first; i != items.second; ++i)
 		addSubItem(new MenuItem(extensions.outlineFonts(), i->second));
@@ -179,7 +180,7 @@ void MainMenu::HelpItem::update(bool isCurrent)
 	MenuTextItem::update(isCurrent);
 	if(isCurrent)
 		{
-		rot += timer.restart() / 1000.0 * ROTATION_SPEED;
+		rot += timer.restartMicroseconds() / 1000000.0 * ROTATION_SPEED;
 		if(rot >= 360.0)
 			rot -= 360.0;
 		}
@@ -187,34 +188,34 @@ void MainMenu::HelpItem::update(bool isCurrent)
 
 void MainMenu::HelpItem::rotateAnimation()
 	{
-	glLoadIdentity();
-	glTranslatef(0.5, 0.0, -6.0);
-	glRotatef(rot, -1.0, 0.0, 0.0);
-	glCallList(modelList);
-	glLoadIdentity();
-	glTranslatef(1.4, 0.0, -6.0);
-	glRotatef(rot, 0.0, -1.0, 0.0);
-	glCallList(modelList);
-	glLoadIdentity();
-	glTranslatef(2.3, 0.0, -6.0);
-	glRotatef(rot, 0.0, 0.0, -1.0);
-	glCallList(modelList);
+	renderer.loadIdentity();
+	renderer.translate(0.5, 0.0, -6.0);
+	renderer.rotate(rot, -1.0, 0.0, 0.0);
+	model.draw(renderer);
+	renderer.loadIdentity();
+	renderer.translate(1.4, 0.0, -6.0);
+	renderer.rotate(rot, 0.0, -1.0, 0.0);
+	model.draw(renderer);
+	renderer.loadIdentity();
+	renderer.translate(2.3, 0.0, -6.0);
+	renderer.rotate(rot, 0.0, 0.0, -1.0);
+	model.draw(renderer);
 	}
 
 void MainMenu::HelpItem::moveAnimation()
 	{
-	glLoadIdentity();
-	glTranslatef(0.5, 0.0, -6.0);
-	glTranslatef(MOVE_AMPLITUDE * sin(rot * M_PI / 180), 0.0, 0.0);
-	glCallList(modelList);
-	glLoadIdentity();
-	glTranslatef(1.4, 0.0, -6.0);
-	glTranslatef(0.0, MOVE_AMPLITUDE * sin(rot * M_PI / 180), 0.0);
-	glCallList(modelList);
-	glLoadIdentity();
-	glTranslatef(2.3, 0.0, -6.0);
-	glTranslatef(0.0, 0.0, MOVE_AMPLITUDE * sin(rot * M_PI / 180));
-	glCallList(modelList);
+	renderer.loadIdentity();
+	renderer.translate(0.5, 0.0, -6.0);
+	renderer.translate(MOVE_AMPLITUDE * sin(rot * M_PI / 180), 0.0, 0.0);
+	model.draw(renderer);
+	renderer.loadIdentity();
+	renderer.translate(1.4, 0.0, -6.0);
+	renderer.translate(0.0, MOVE_AMPLITUDE * sin(rot * M_PI / 180), 0.0);
+	model.draw(renderer);
+	renderer.loadIdentity();
+	renderer.translate(2.3, 0.0, -6.0);
+	renderer.translate(0.0, 0.0, MOVE_AMPLITUDE * sin(rot * M_PI / 180));
+	model.draw(renderer);
 	}
 
 //----------------------------------------------------------------------------
@@ -367,7 +368,7 @@ MainMenu::MainMenu(CuTeWindow& win, MyXML::Key& iOptions):
 		lexical_cast<int>(langInfo["fonts"]["large"].attribute("size")) * win.width() / 1024, 0.09);
 
 	buildMenu();		//create all main and sub menu hierarchy
-	atom.useModel(models["atomModel"]);
+	atom.useModel(renderer(), models["atomModel"]);
 	menu[DIFFICULTY].subMenu()->currentIndex(difficulty.level());		//set up difficulty menu position
 	}
 
@@ -245,11 +245,12 @@ namespace CuTe
 					///@sa rotateAnimation()
 					///@sa draw()
 					void moveAnimation();
-					///OpenGL list index name where the help model block is saved.
-					///The help model block is built in buildModel() method. The block is then used in
+					///Renderer the help model block is drawn with.
+					GLRenderer renderer;
+					///Help model block.
+					///The help model block is built in the constructor. The block is then used in
 					///moveAnimation() and rotateAnimation()
-					///@sa buildModel()
-					const GLuint modelList;
+					XMLModel model;
 					///Puts a centered string to a specified position.
 					///Moves the current bitmap fonts position to (x, y) and prints the message.
 					///The message is centered, so that x is the position of the middle of the message.
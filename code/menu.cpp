@@ -105,7 +105,7 @@ MenuItem* Menu::addItem(MenuItem *item)
 
 void Menu::update()
 	{
-	decAbs<float>(angleShift, static_cast<float>(timer.restart()) / ITEMS_PERIOD * ITEMS_ANGLE);
+	decAbs<float>(angleShift, static_cast<float>(timer.restartMicroseconds() / 1000.0) / ITEMS_PERIOD * ITEMS_ANGLE);
 	}
 
 void Menu::previous()
@@ -184,7 +184,7 @@ void MenuItem::update(bool isCurrent)
 		scale = 1.0;
 		wasCurrent = isCurrent;
 		}
-	decAbs<float>(scale, scaleTimer.restart() / 1000.0 * SCALE_CHANGE_SPEED);
+	decAbs<float>(scale, scaleTimer.restartMicroseconds() / 1000000.0 * SCALE_CHANGE_SPEED);
 	}
 
 //----------------------------------------------------------------------------
@@ -216,17 +216,18 @@ std::string MenuScene::playerName;
 MenuScene::MenuScene(CuTeWindow& iWin, Difficulty& iDifficulty):
 	CuTeScene(iWin), difficulty(iDifficulty)
 	{
+	frameRate(MENU_FRAME_RATE);
 	}
 
 void MenuScene::refresh()
 	{
 	checkInput();
-	background.draw(win.extensions().textures());
+	background.draw(renderer());
 	menu.drawVertically();
-	glLoadIdentity();
-	glTranslatef(1.7, 1.3, -6.0);
-	win.extensions().textures().select(0);
-	atom.draw();
+	renderer().loadIdentity();
+	renderer().translate(1.7, 1.3, -6.0);
+	renderer().texture(0);
+	atom.draw(renderer());
 	drawInfo();
 	}
 
@@ -266,35 +267,36 @@ MenuScene::Background<DETAILS, WIDTH>::Background(float iBrightness, float iZDis
 	}
 
 template<int DETAILS, int WIDTH>
-void MenuScene::Background<DETAILS, WIDTH>::draw(MyOGL::Textures& textures)
+void MenuScene::Background<DETAILS, WIDTH>::draw(Renderer& renderer)
 	{
 	update();		//update background data before rendering
-	textures.enable();
-	textures.select(1);
-	glLoadIdentity();
-	glTranslatef(0.0, 0.0, zDist);
-	glColorHSV(0.0, 0.0, brightness);
-	glBegin(GL_QUADS);
+	renderer.enable(Renderer::TEXTURE);
+	renderer.texture(1);
+	renderer.loadIdentity();
+	renderer.translate(0.0, 0.0, zDist);
+	renderer.colorHSV(0.0, 0.0, brightness);
+	boost::array<Renderer::TexVertex, DETAILS * DETAILS * 4> quads;
+	typename boost::array<Renderer::TexVertex, DETAILS * DETAILS * 4>::iterator vertex = quads.begin();
 	Point<float, 2> texCoords;
 	Point<float, 2> quadCoords;
 	for(int x = 0; x < DETAILS; ++x)
 		for(int y = 0; y < DETAILS; ++y)
-			{
-			texCoords.x() = x * UNIT;
-			texCoords.y() = y * UNIT;
-			quadCoords.x() = WIDTH * (texCoords.x() - 0.5);
-			quadCoords.y() = WIDTH * (texCoords.y() - 0.5);
-			glTexCoord2f(texCoords.x(), texCoords.y());
-			glVertex3f(quadCoords.x(), quadCoords.y(), heights[x][y]);
-			glTexCoord2f(texCoords.x() + UNIT, texCoords.y());
-			glVertex3f(quadCoords.x() + WIDTH * UNIT, quadCoords.y(), heights[x + 1][y]);
-			glTexCoord2f(texCoords.x() + UNIT, texCoords.y() + UNIT);
-			glVertex3f(quadCoords.x() + WIDTH * UNIT, quadCoords.y() + WIDTH * UNIT, heights[x + 1][y + 1]);
-			glTexCoord2f(texCoords.x(), texCoords.y() + UNIT);
-			glVertex3f(quadCoords.x(), quadCoords.y() + WIDTH * UNIT, heights[x][y + 1]);
-			}
-	glEnd();
-	textures.disable();
+			for(int corner = 0; corner < 4; ++corner, ++vertex)
+				{		//corners counter clockwise, starting at (x, y)
+				const int dx = (corner == 1) || (corner == 2);
+				const int dy = corner / 2;
+				texCoords.x() = (x + dx) * UNIT;
+				texCoords.y() = (y + dy) * UNIT;
+				quadCoords.x() = WIDTH * (texCoords.x() - 0.5);
+				quadCoords.y() = WIDTH * (texCoords.y() - 0.5);
+				vertex->s = texCoords.x();
+				vertex->t = texCoords.y();
+				vertex->x = quadCoords.x();
+				vertex->y = quadCoords.y();
+				vertex->z = heights[x + dx][y + dy];
+				}
+	renderer.draw(Renderer::QUADS, Renderer::T2F_V3F, quads.data(), static_cast<int>(quads.size()));
+	renderer.disable(Renderer::TEXTURE);
 	}
 
 template<int DETAILS, int WIDTH>
@@ -371,11 +371,11 @@ namespace CuTe
 					///@param iZDist Z distance from the GL viewport to the game logo polygon position.
 					Background(float iBrightness, float iZDist);
 					///Draws the menu background.
-					///@param textures Textures object to use when drawing. This reference can't be given in
-					///the constructor because the object is created statically at the very beginning (when even
-					///the Window object might not exist!)
+					///@param renderer Renderer to draw with. This reference can't be given in the constructor
+					///because the object is created statically at the very beginning (when even the Window
+					///object might not exist!)
 					///@sa update()
-					void draw(MyOGL::Textures& textures);
+					void draw(Renderer& renderer);
 				private:
 					///Number of details per one OpenGL unit.
 					///This constant is usefull when drawing the background, because it simplyfies and speeds
@@ -419,6 +419,11 @@ namespace CuTe
 				};		//class Background
 
 		protected:
+			///Frame rate limit of menu scenes.
+			///The menu background and atom move slowly, so drawing them more often would only use the
+			///processor time.
+			///@sa MyOGL::Scene::frameRate()
+			static const int MENU_FRAME_RATE = 30;
 			///Menu object.
 			///Collects all menu items. Use  drawVertically() to draw the vertical menu wheel on
 			///the left of the screen.
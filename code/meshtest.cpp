@@ -0,0 +1,222 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Checks of the cuboid mesh and its drawing.
+///
+///Small boards with known numbers of the visible and the merged faces are meshed, and the
+///commands CuboidView sends to a RenderRecorder are counted. Prints every failed check and
+///returns non-zero if any failed (run by ctest from the main directory, it needs data/).
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/lexical_cast.hpp>
+#include "cuboidview.h"
+#include "difficulty.h"
+#include "selfplay.h"
+using namespace CuTe;
+
+//----------------------------------------------------------------------------
+
+namespace
+	{
+
+	///Size of all the checked boards.
+	const int SIZE = 5;
+	///Depth of all the checked boards.
+	const int DEPTH = 4;
+
+	///Number of failed checks.
+	int failures = 0;
+
+	///Reports a failed check.
+	///@param name Name of the check.
+	///@param value Value found.
+	///@param expected Value which should be found.
+	void check(const std::string& name, int value, int expected)
+		{
+		if(value != expected)
+			{
+			std::cerr << name << ": " << value << " instead of " << expected << std::endl;
+			++failures;
+			}
+		}
+
+	///Empty board which the single cubes are put on.
+	class Board
+		{
+		private:
+			///Difficulty data.
+			MyXML::Key diffData;
+			///Game difficulty, reads diffData.
+			Difficulty difficulty;
+			///Game which is not played, it only gives the single cube block.
+			SelfPlay game;
+			///Single cube block.
+			Block cube;
+		public:
+			///The board.
+			Cuboid cuboid;
+			///Creates an empty board SIZE x SIZE x depth.
+			explicit Board(int depth = DEPTH): diffData(key(depth)), difficulty(diffData), game(difficulty, 0),
+				cuboid(SIZE, depth)
+				{
+				std::vector<Block>::const_iterator block = game.allBlocks().begin();
+				while(block->cubes().size() != 1)
+					++block;		//every blocks set has a single cube block
+				cube = *block;
+				}
+			///Returns the difficulty data key.
+			static MyXML::Key key(int depth)
+				{
+				MyXML::Key data;
+				data.attribute("size") = boost::lexical_cast<std::string>(SIZE);
+				data.attribute("depth") = boost::lexical_cast<std::string>(depth);
+				data.attribute("blocksSet") = "0";
+				return data;
+				}
+			///Puts a cube on the board.
+			void put(int x, int y, int z)
+				{
+				cube.pos() = Point<int, 3>(x, y, z);
+				cuboid.put(cube);
+				}
+			///Fills a whole Z plane.
+			void fill(int z)
+				{
+				for(int y = 0; y < SIZE; ++y)
+					for(int x = 0; x < SIZE; ++x)
+						put(x, y, z);
+				}
+		};
+
+	///Returns the number of faces in the mesh of a cuboid with no planes moving.
+	int faces(const Cuboid& cuboid, bool greedy)
+		{
+		CuboidMesh mesh(greedy);
+		mesh.update(cuboid, std::vector<double>(cuboid.depth(), 0.0));
+		return mesh.faces();
+		}
+
+	///Checks the numbers of culled and merged faces.
+	void checkFaces()
+		{
+		Board one;
+		one.put(2, 2, 0);
+		check("one cube culled", faces(one.cuboid, false), 6);
+		check("one cube greedy", faces(one.cuboid, true), 6);
+		Board two;
+		two.put(0, 0, 0);		//in the corner, so the faces around them merge into two rectangles
+		two.put(1, 0, 0);
+		check("two cubes culled", faces(two.cuboid, false), 10);
+		check("two cubes greedy", faces(two.cuboid, true), 6);
+		two.fill(1);
+		check("two cubes under a plane culled", faces(two.cuboid, false), 76);
+		check("two cubes under a plane greedy", faces(two.cuboid, true), 12);
+		}
+
+	///Checks that only the changed chunks are built and the moved ones are reused.
+	void checkUpdates()
+		{
+		const int depth = DEPTH + 1;
+		Board board(depth);
+		board.put(2, 2, 0);
+		board.fill(1);
+		board.put(2, 2, 3);
+		std::vector<double> planesShift(depth, 0.0);
+		CuboidMesh mesh;
+		mesh.update(board.cuboid, planesShift);
+		check("first update rebuilt", mesh.rebuilt(), depth);
+		mesh.update(board.cuboid, planesShift);
+		check("unchanged update rebuilt", mesh.rebuilt(), 0);
+		check("unchanged update changed", mesh.changed(), false);
+		std::vector<bool> removed(depth);
+		check("removed planes", board.cuboid.removeFilledPlanes(removed), 1);
+		for(int z = 1; z < depth; ++z)
+			planesShift[z] = 1.0;		//planes above the removed one are drawn where they were
+		mesh.update(board.cuboid, planesShift);
+		check("moved cube source", mesh.source(2), 3);
+		check("update after removal changed", mesh.changed(), true);
+		check("faces after removal", mesh.faces(), 12);
+		for(int z = 1; z < depth; ++z)
+			planesShift[z] = 0.0;		//the planes shift animation is over
+		mesh.update(board.cuboid, planesShift);
+		check("faces after shift", mesh.faces(), 12);
+		}
+
+	///Checks the commands CuboidView draws a board with.
+	void checkView()
+		{
+		Board board;
+		board.put(2, 2, 0);
+		board.put(3, 2, 0);
+		board.put(2, 2, 2);
+		const std::vector<double> planesShift(DEPTH, 0.0);
+		CuboidView view;
+		RenderRecorder recorder;
+		view.draw(recorder, board.cuboid, planesShift, 1.0);
+		check("first frame meshes", recorder.count(RenderRecorder::CREATE_MESH), 2);
+		recorder.clear();
+		view.draw(recorder, board.cuboid, planesShift, 1.0);
+		check("frame meshes", recorder.count(RenderRecorder::CREATE_MESH), 0);
+		check("frame draws", recorder.draws(), 2);
+		check("frame vertices", recorder.vertices(), (10 + 6) * CuboidMesh::FACE_VERTICES);
+		check("frame state changes", recorder.stateChanges(), 3);
+		board.put(3, 3, 2);
+		recorder.clear();
+		view.draw(recorder, board.cuboid, planesShift, 1.0);
+		check("changed frame created meshes", recorder.count(RenderRecorder::CREATE_MESH), 1);
+		check("changed frame deleted meshes", recorder.count(RenderRecorder::DELETE_MESH), 1);
+		check("changed frame vertices", recorder.vertices(), (10 + 12) * CuboidMesh::FACE_VERTICES);
+		view.release(recorder);
+		check("released meshes", recorder.liveMeshes(), 0);
+		}
+
+	}
+
+//----------------------------------------------------------------------------
+
+int main()
+	{
+	try
+		{
+		checkFaces();
+		checkUpdates();
+		checkView();
+		}
+	catch(const std::exception& e)
+		{
+		std::cerr << e.what() << std::endl;
+		return 1;
+		}
+	if(failures > 0)
+		return 1;
+	std::cout << "All checks passed" << std::endl;
+	return 0;
+	}
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,218 @@
+//----------------------------------------------------------------------------
+
+///@file
+///MoveGenerator class definitions.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include <cctype>
+#include <algorithm>
+#include "movegenerator.h"
+using namespace CuTe;
+
+//----------------------------------------------------------------------------
+
+const std::string MoveGenerator::rotationCodes = "xXyYzZ";
+const int MoveGenerator::SINGLE_MOVES;
+const int MoveGenerator::NOT_MOVED;
+
+//----------------------------------------------------------------------------
+
+MoveGenerator::MoveGenerator(const Cuboid& board, const Block& iStart, bool combined):
+	start(iStart), sizeRange(board.size() + 2 * iStart.range()),
+	nearestZ(std::min(iStart.pos().z(), board.depth() - 1 - iStart.range()))
+	{
+	depthRange = start.pos().z() - nearestZ + 1;
+	for(int r = -1; r < static_cast<int>(rotationCodes.length()); ++r)
+		for(int shiftX = -1; shiftX <= 1; ++shiftX)
+			for(int shiftY = -1; shiftY <= 1; ++shiftY)
+				{		//steps without rotation first, so that rotations are done only when needed
+				const int parts = (r >= 0) + (shiftX != 0) + (shiftY != 0);
+				if((parts == 1) || (combined && (parts > 1)))
+					{
+					const Step move = {(r >= 0)? rotationCodes[r] : '\0', shiftX, shiftY};
+					steps.push_back(move);
+					}
+				}
+	const int orientations = start.shape()->orientations();
+	distances.resize(orientations * depthRange * sizeRange * sizeRange, -1);
+	previous.resize(distances.size(), -1);
+	previousStep.resize(distances.size(), -1);
+	placements.resize(orientations * sizeRange * sizeRange, -1);
+	const int first = index(start);
+	if((first < 0) || !board.canPut(start))
+		return;		//block doesn't fit at all, nothing is reachable
+	distances[first] = 0;
+	placements[placementIndex(start)] = first;
+	//single steps are done only once each, so there is no need to remember them
+	std::vector<int> moved(combined? distances.size() * SINGLE_MOVES : 0, NOT_MOVED);
+	std::vector<int> queue(1, first);
+	for(unsigned int i = 0; i < queue.size(); ++i)
+		{		//breadth first search, so every state is reached in the least number of steps
+		for(unsigned int s = 0; s < steps.size(); ++s)
+			{
+			const int reached = stepState(board, queue[i], steps[s], moved);
+			if((reached < 0) || (distances[reached] >= 0))
+				continue;		//step impossible (or done only partially, a shorter one does the same)
+			distances[reached] = distances[queue[i]] + 1;
+			previous[reached] = queue[i];
+			previousStep[reached] = s;
+			Block to = start;
+			state(reached, to);
+			int& placement = placements[placementIndex(to)];
+			if(placement < 0)		//the first state found is the nearest one
+				placement = reached;
+			queue.push_back(reached);
+			}
+		}
+	}
+
+bool MoveGenerator::step(const Cuboid& board, Block& block, const Step& move)
+	{
+	if(move.rotation != '\0')
+		{		//rotate like Engine::rotateXCW() and others do
+		Block rotated = block;
+		const bool CCW = isupper(move.rotation) != 0;
+		switch(toupper(move.rotation))
+			{
+			case 'X': rotated.rotateX(CCW); break;
+			case 'Y': rotated.rotateY(CCW); break;
+			case 'Z': rotated.rotateZ(CCW); break;
+			default: throw CuTeEx("Bad block rotation char code");
+			}
+		if(!board.canPut(rotated) && !board.tryMove(rotated))
+			return false;
+		block = rotated;
+		}
+	if(move.shiftX != 0)
+		{
+		block.pos().x() += move.shiftX;
+		if(!board.canPut(block))
+			{
+			block.pos().x() -= move.shiftX;
+			return false;
+			}
+		}
+	if(move.shiftY != 0)
+		{
+		block.pos().y() += move.shiftY;
+		if(!board.canPut(block))
+			{
+			block.pos().y() -= move.shiftY;
+			return false;
+			}
+		}
+	return true;
+	}
+
+int MoveGenerator::moveState(const Cuboid& board, int stateIndex, int single, std::vector<int>& moved) const
+	{
+	int* result = moved.empty()? NULL : &moved[stateIndex * SINGLE_MOVES + single];
+	if((result != NULL) && (*result != NOT_MOVED))
+		return *result;		//already checked
+	const int rotations = rotationCodes.length();
+	const Step move = {(single < rotations)? rotationCodes[single] : '\0',
+		(single == rotations)? -1 : ((single == rotations + 1)? 1 : 0),
+		(single == rotations + 2)? -1 : ((single == rotations + 3)? 1 : 0)};
+	Block block = start;
+	state(stateIndex, block);
+	const int moveResult = step(board, block, move)? index(block) : -1;
+	if(result != NULL)
+		*result = moveResult;
+	return moveResult;
+	}
+
+int MoveGenerator::stepState(const Cuboid& board, int stateIndex, const Step& move, std::vector<int>& moved) const
+	{
+	const int rotations = rotationCodes.length();
+	if((move.rotation != '\0') && (stateIndex >= 0))
+		stateIndex = moveState(board, stateIndex, rotationCodes.find(move.rotation), moved);
+	if((move.shiftX != 0) && (stateIndex >= 0))
+		stateIndex = moveState(board, stateIndex, rotations + (move.shiftX > 0), moved);
+	if((move.shiftY != 0) && (stateIndex >= 0))
+		stateIndex = moveState(board, stateIndex, rotations + 2 + (move.shiftY > 0), moved);
+	return stateIndex;
+	}
+
+int MoveGenerator::index(const Block& block) const
+	{
+	const int x = block.pos().x() + start.range();
+	const int y = block.pos().y() + start.range();
+	const int z = block.pos().z() - nearestZ;
+	if((x < 0) || (x >= sizeRange) || (y < 0) || (y >= sizeRange) || (z < 0) || (z >= depthRange))
+		return -1;
+	return ((block.orientation() * depthRange + z) * sizeRange + y) * sizeRange + x;
+	}
+
+int MoveGenerator::placementIndex(const Block& block) const
+	{
+	const int x = block.pos().x() + start.range();
+	const int y = block.pos().y() + start.range();
+	if((x < 0) || (x >= sizeRange) || (y < 0) || (y >= sizeRange))
+		return -1;
+	return (block.orientation() * sizeRange + y) * sizeRange + x;
+	}
+
+void MoveGenerator::state(int stateIndex, Block& block) const
+	{
+	block.pos().x() = stateIndex % sizeRange - start.range();
+	stateIndex /= sizeRange;
+	block.pos().y() = stateIndex % sizeRange - start.range();
+	stateIndex /= sizeRange;
+	block.pos().z() = stateIndex % depthRange + nearestZ;
+	block.orientation(stateIndex / depthRange);
+	}
+
+int MoveGenerator::reachedState(const Block& block) const
+	{
+	const int placement = placementIndex(block);
+	return ((placement < 0) || (placement >= static_cast<int>(placements.size())))? -1 : placements[placement];
+	}
+
+bool MoveGenerator::reach(Block& block) const
+	{
+	const int reached = reachedState(block);
+	if(reached < 0)
+		return false;
+	state(reached, block);
+	return true;
+	}
+
+int MoveGenerator::distance(const Block& block) const
+	{
+	const int reached = reachedState(block);
+	return (reached < 0)? -1 : distances[reached];
+	}
+
+MoveGenerator::Path MoveGenerator::path(const Block& block) const
+	{
+	Path found;
+	for(int reached = reachedState(block); (reached >= 0) && (previous[reached] >= 0); reached = previous[reached])
+		found.push_back(steps[previousStep[reached]]);
+	std::reverse(found.begin(), found.end());
+	return found;
+	}
+
+//----------------------------------------------------------------------------
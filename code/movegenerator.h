@@ -0,0 +1,176 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Generator of block placements reachable by real moves and rotations.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#ifndef MOVEGENERATOR_H
+#define MOVEGENERATOR_H
+
+//----------------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+#include "engine.h"
+
+//----------------------------------------------------------------------------
+
+namespace CuTe
+	{
+
+//----------------------------------------------------------------------------
+
+	///Finds all the block positions reachable from the starting one.
+	///@par
+	///Not every (x, y) position and orientation in which the block fits on a cuboid can really be
+	///reached: the block may have to pass through a wall of cubes or rotate where there is no room
+	///for it. This class searches (breadth first) all the (x, y, z, orientation) states which can
+	///be reached by moving and rotating the block with the same rules as Engine uses (including
+	///moving the block away from the walls in Cuboid::tryMove()). For every reachable state the
+	///shortest sequence of steps leading to it is known.
+	///@par
+	///A single step is what BlockAnalyzer::transformBlock() does at once: one rotation followed by
+	///a move along X and a move along Y, each of them optional.
+	///@sa BlockAnalyzer
+	class MoveGenerator
+		{
+		public:
+			///Single transformation step.
+			struct Step
+				{
+				///Rotation code ('x', 'y' or 'z', uppercase is counterclockwise) or 0 if no rotation.
+				///@sa BlockAnalyzer::rotateBlock()
+				char rotation;
+				///Move along X axis: -1, 0 or 1.
+				int shiftX;
+				///Move along Y axis: -1, 0 or 1.
+				int shiftY;
+				};
+			///Sequence of steps transforming the block from the starting position.
+			typedef std::vector<Step> Path;
+		private:
+			///Rotation codes tried in every step.
+			static const std::string rotationCodes;
+			///Number of single moves: every rotation from rotationCodes and moves left, right, down
+			///and up (in this order).
+			///@sa moveState()
+			static const int SINGLE_MOVES = 10;
+			///Marks single move which wasn't checked yet.
+			///@sa moveState()
+			static const int NOT_MOVED = -2;
+			///All the steps tried from every state.
+			///If combined steps are used, these are all the combinations of a rotation and moves
+			///along both axes, otherwise only single rotations and single moves.
+			std::vector<Step> steps;
+			///Block in starting position.
+			Block start;
+			///Number of block positions along X and Y axes.
+			///Block middle cube can be at most range() fields inside the walls.
+			int sizeRange;
+			///Number of block positions along Z axis.
+			///The block is moved along Z only back from the top wall (see Cuboid::tryMove()), so its Z
+			///coordinate is between nearestZ and the starting one.
+			int depthRange;
+			///Z coordinate of the nearest block position.
+			int nearestZ;
+			///Number of steps needed to reach every state, -1 if the state is unreachable.
+			///@sa index()
+			std::vector<int> distances;
+			///Index of the state from which every state was reached.
+			std::vector<int> previous;
+			///Index of a step (in steps) used to reach every state.
+			std::vector<int> previousStep;
+			///The nearest reached state for every (x, y, orientation), -1 if there is none.
+			///@sa placementIndex()
+			std::vector<int> placements;
+			///Returns the state index of a block position or -1 if it is out of range.
+			int index(const Block& block) const;
+			///Returns the placement index of a block (x, y) position and orientation.
+			///@return Index in placements or -1 if the block is out of range.
+			int placementIndex(const Block& block) const;
+			///Changes the block to the one in a given state.
+			///@param stateIndex State index as returned by index().
+			///@param block Block to change.
+			void state(int stateIndex, Block& block) const;
+			///Does a single move from a state.
+			///Every single move is checked only once and remembered, so combined steps (which consist
+			///of single moves) cost nearly nothing.
+			///@param board Cuboid on which the block is moved.
+			///@param stateIndex State to move from.
+			///@param single Single move index in range <0; SINGLE_MOVES)
+			///@param moved Results of the single moves checked so far, indexed
+			///[stateIndex * SINGLE_MOVES + single], NOT_MOVED if not checked yet; if it is empty, the
+			///results are not remembered.
+			///@return Index of the state after the move or -1 if the move is impossible.
+			int moveState(const Cuboid& board, int stateIndex, int single, std::vector<int>& moved) const;
+			///Does a step from a state using moveState().
+			///@return Index of the state after the whole step or -1 if it can't be done.
+			///@sa moveState()
+			int stepState(const Cuboid& board, int stateIndex, const Step& move, std::vector<int>& moved) const;
+			///Returns the reached state of a block (x, y) position and orientation.
+			///@return Reached state index or -1 if the block can't be placed there.
+			int reachedState(const Block& block) const;
+		public:
+			///Creates generator with no reachable states.
+			MoveGenerator(): sizeRange(0), depthRange(0), nearestZ(0)	{}
+			///Finds all the states reachable on a cuboid.
+			///@param board Cuboid on which the block is moved.
+			///@param iStart Block in its starting position; normally it should fit on the cuboid.
+			///@param combined If true, the steps combine a rotation and both moves (so paths are the
+			///shortest in BlockAnalyzer::transformBlock() calls), otherwise every step is a single
+			///rotation or move (the same states are reachable, but the search is faster).
+			MoveGenerator(const Cuboid& board, const Block& iStart, bool combined = true);
+			///Does a single step with the same rules as Engine.
+			///@param board Cuboid on which the block is moved.
+			///@param block Block to transform.
+			///@param move Step to do.
+			///@return True if all the parts of the step were done; block is left after the last one done.
+			static bool step(const Cuboid& board, Block& block, const Step& move);
+			///Checks whether the block can reach (x, y) position in given orientation.
+			///If it can, block Z coordinate is changed to the one in which the position is reached in
+			///the least number of steps (the block can be moved back from the top wall on the way).
+			///@param block Block with (x, y) position and orientation to check.
+			///@return True if the position is reachable.
+			bool reach(Block& block) const;
+			///Returns the number of steps to reach the (x, y) position in given orientation.
+			///@param block Block with (x, y) position and orientation to check.
+			///@return Number of steps or -1 if the position is unreachable.
+			int distance(const Block& block) const;
+			///Returns the shortest path to the (x, y) position in given orientation.
+			///@param block Block with (x, y) position and orientation to reach.
+			///@return Steps to do, empty if the position is unreachable (or it is the starting one).
+			Path path(const Block& block) const;
+		};		//class MoveGenerator
+
+//----------------------------------------------------------------------------
+
+	}		//namespace CuTe
+
+//----------------------------------------------------------------------------
+
+#endif		//#define MOVEGENERATOR_H
+
+//----------------------------------------------------------------------------
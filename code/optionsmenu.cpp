@@ -203,7 +203,7 @@ void Options::PlayerNameItem::update(bool isCurrent)
 		{
 		if(isCurrent)
 			checkInput();		//check for letters, digits, etc. or [Backspace]
-		decAbs<float>(alpha, alphaTimer.restart() / 1000.0 * NAME_EDIT_ALPHA_SPEED);
+		decAbs<float>(alpha, alphaTimer.restartMicroseconds() / 1000000.0 * NAME_EDIT_ALPHA_SPEED);
 		}
 	}
 
@@ -0,0 +1,111 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Fast seedable pseudo random numbers generator.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+//----------------------------------------------------------------------------
+
+#include <boost/cstdint.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace CuTe
+	{
+
+//----------------------------------------------------------------------------
+
+	///Pseudo random numbers generator (xoshiro256**).
+	///@par
+	///Unlike rand(), every object has its own state, so the same seed always gives the same numbers
+	///no matter what else is going on in the program (e.g. in other threads). The state is filled
+	///with splitmix64 from the seed, so even the neighbouring seeds (like seed and seed + 1) give
+	///unrelated sequences.
+	class Random
+		{
+		private:
+			///Generator state.
+			boost::uint64_t state[4];
+			///Seed the generator was started with.
+			///@sa seed()
+			boost::uint64_t seed_;
+			///Rotates the bits left.
+			static boost::uint64_t rotl(boost::uint64_t value, int bits)	{return (value << bits) | (value >> (64 - bits));}
+		public:
+			///Creates the generator.
+			///@param iSeed Initial seed, see seed(boost::uint64_t).
+			explicit Random(boost::uint64_t iSeed)	{seed(iSeed);}
+			///Returns the seed the generator was (re)started with.
+			boost::uint64_t seed() const	{return seed_;}
+			///Restarts the generator.
+			///@param newSeed Seed; any value is fine (including 0).
+			void seed(boost::uint64_t newSeed)
+				{
+				seed_ = newSeed;
+				for(int i = 0; i < 4; ++i)
+					{		//splitmix64
+					newSeed += 0x9E3779B97F4A7C15ULL;
+					boost::uint64_t value = newSeed;
+					value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+					value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+					state[i] = value ^ (value >> 31);
+					}
+				}
+			///Returns the next 64 random bits.
+			boost::uint64_t next()
+				{
+				const boost::uint64_t result = rotl(state[1] * 5, 7) * 9;
+				const boost::uint64_t shifted = state[1] << 17;
+				state[2] ^= state[0];
+				state[3] ^= state[1];
+				state[1] ^= state[2];
+				state[0] ^= state[3];
+				state[2] ^= shifted;
+				state[3] = rotl(state[3], 45);
+				return result;
+				}
+			///Returns a random integer.
+			///@param range Number of possible values, at least 1.
+			///@return Value in range <0; range)
+			int operator()(int range)
+				{return static_cast<int>(((next() >> 32) * static_cast<boost::uint64_t>(range)) >> 32);}
+			///Returns a random real number.
+			///@return Value in range <0; 1)
+			double real()	{return (next() >> 11) * (1.0 / 9007199254740992.0);}
+		};		//class Random
+
+//----------------------------------------------------------------------------
+
+	}		//namespace CuTe
+
+//----------------------------------------------------------------------------
+
+#endif		//#define RANDOM_H
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,219 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Renderer and RenderRecorder classes definitions.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+#include "render.h"
+#include "engine.h"
+#include "MyOGL/hsv2rgb.h"
+using namespace CuTe;
+using namespace std;
+
+//----------------------------------------------------------------------------
+
+int Renderer::vertexSize(Format format)
+	{
+	switch(format)
+		{
+		case V3F: return sizeof(PosVertex);
+		case C4UB_V3F: return sizeof(ColorVertex);
+		case T2F_V3F: return sizeof(TexVertex);
+		default: return sizeof(TexColorVertex);
+		}
+	}
+
+Renderer::~Renderer()	{}
+
+void Renderer::colorHSV(float hue, float saturation, float value, float alpha)
+	{
+	float rgb[3];
+	MyOGL::hsv2rgb(hue, saturation, value, rgb);
+	color(rgb[0], rgb[1], rgb[2], alpha);
+	}
+
+//----------------------------------------------------------------------------
+
+RenderRecorder::RenderRecorder(): used(0), vertices_(0), lastMesh(0)
+	{
+	fill(counts, counts + COMMAND_TYPES, 0);
+	}
+
+RenderRecorder::Command& RenderRecorder::add(CommandType type, int extra)
+	{
+	const int size = sizeof(Command) + extra;
+	if(used + size > static_cast<int>(arena.size()))
+		arena.resize(max(2 * arena.size(), arena.size() + size));		//commands before are copied
+	Command& command = *reinterpret_cast<Command*>(&arena[used]);
+	command.type = type;
+	command.size = size;
+	used += size;
+	++counts[type];
+	return command;
+	}
+
+void RenderRecorder::clear()
+	{
+	used = 0;
+	vertices_ = 0;
+	fill(counts, counts + COMMAND_TYPES, 0);
+	}
+
+const RenderRecorder::Command* RenderRecorder::first() const
+	{
+	return (used > 0)? reinterpret_cast<const Command*>(&arena[0]) : 0;
+	}
+
+const RenderRecorder::Command* RenderRecorder::next(const Command* command) const
+	{
+	const char* const next = reinterpret_cast<const char*>(command) + command->size;
+	return (next < &arena[0] + used)? reinterpret_cast<const Command*>(next) : 0;
+	}
+
+int RenderRecorder::commands() const
+	{
+	int sum = 0;
+	for(int type = 0; type < COMMAND_TYPES; ++type)
+		sum += counts[type];
+	return sum;
+	}
+
+void RenderRecorder::loadIdentity()
+	{
+	add(LOAD_IDENTITY);
+	}
+
+void RenderRecorder::pushMatrix()
+	{
+	add(PUSH_MATRIX);
+	}
+
+void RenderRecorder::popMatrix()
+	{
+	add(POP_MATRIX);
+	}
+
+void RenderRecorder::translate(float x, float y, float z)
+	{
+	Command& command = add(TRANSLATE);
+	command.args[0] = x;
+	command.args[1] = y;
+	command.args[2] = z;
+	}
+
+void RenderRecorder::scale(float x, float y, float z)
+	{
+	Command& command = add(SCALE);
+	command.args[0] = x;
+	command.args[1] = y;
+	command.args[2] = z;
+	}
+
+void RenderRecorder::rotate(float angle, float x, float y, float z)
+	{
+	Command& command = add(ROTATE);
+	command.args[0] = angle;
+	command.args[1] = x;
+	command.args[2] = y;
+	command.args[3] = z;
+	}
+
+void RenderRecorder::enable(Capability capability)
+	{
+	add(ENABLE).param = capability;
+	}
+
+void RenderRecorder::disable(Capability capability)
+	{
+	add(DISABLE).param = capability;
+	}
+
+void RenderRecorder::texture(int index)
+	{
+	add(TEXTURE).param = index;
+	}
+
+void RenderRecorder::fog(float start, float end)
+	{
+	Command& command = add(FOG);
+	command.args[0] = start;
+	command.args[1] = end;
+	}
+
+void RenderRecorder::color(float red, float green, float blue, float alpha)
+	{
+	Command& command = add(COLOR);
+	command.args[0] = red;
+	command.args[1] = green;
+	command.args[2] = blue;
+	command.args[3] = alpha;
+	}
+
+void RenderRecorder::draw(Primitive primitive, Format format, const void* vertices, int count)
+	{
+	const int extra = count * vertexSize(format);
+	Command& command = add(DRAW, extra);
+	command.primitive = primitive;
+	command.format = format;
+	command.count = count;
+	memcpy(&command + 1, vertices, extra);
+	vertices_ += count;
+	}
+
+int RenderRecorder::createMesh(Primitive primitive, Format format, const void* vertices, int count)
+	{
+	const int extra = count * vertexSize(format);
+	Command& command = add(CREATE_MESH, extra);
+	command.param = ++lastMesh;
+	command.primitive = primitive;
+	command.format = format;
+	command.count = count;
+	memcpy(&command + 1, vertices, extra);
+	meshes[lastMesh] = count;
+	return lastMesh;
+	}
+
+void RenderRecorder::drawMesh(int mesh)
+	{
+	const map<int, int>::const_iterator found = meshes.find(mesh);
+	if(found == meshes.end())
+		throw CuTeEx("Drawing a mesh which doesn't exist");
+	Command& command = add(DRAW_MESH);
+	command.param = mesh;
+	command.count = found->second;
+	vertices_ += found->second;
+	}
+
+void RenderRecorder::deleteMesh(int mesh)
+	{
+	if(meshes.erase(mesh) == 0)
+		throw CuTeEx("Deleting a mesh which doesn't exist");
+	add(DELETE_MESH).param = mesh;
+	}
+
+//----------------------------------------------------------------------------
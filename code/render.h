@@ -0,0 +1,272 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Renderer interface and RenderRecorder class declarations.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#ifndef RENDER_H
+#define RENDER_H
+
+//----------------------------------------------------------------------------
+
+#include <map>
+#include <vector>
+
+//----------------------------------------------------------------------------
+
+namespace CuTe
+	{
+
+//----------------------------------------------------------------------------
+
+	///Drawing commands the game is drawn with.
+	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+	///@date Jul 2005-Mar 2006
+	///@par
+	///GLEngine, the scenes, the side bar, the menu background, the atom and the XML models
+	///(XMLModel) don't call OpenGL to draw, they pass the same commands to a renderer. GLRenderer
+	///executes them with OpenGL, RenderRecorder only records them, so the drawing can be measured
+	///without any window.
+	///@par
+	///There is no glBegin()/glEnd(): every draw() gets the whole vertex array at once, in one of
+	///the OpenGL interleaved arrays formats. Meshes are vertex arrays kept by the renderer
+	///(display lists in OpenGL), so they are sent only once and then drawn many times.
+	///@note Text (fonts), the viewports, the camera and the depth test are not set through the
+	///renderer, they still call OpenGL directly. So only a part of a frame can be recorded without
+	///a window: the cuboid (CuboidView, see BM_CuboidFrame), not the whole game screen.
+	class Renderer
+		{
+		public:
+			///States which can be enabled and disabled.
+			enum Capability {BLEND, FOG, TEXTURE};
+			///Primitives the vertices are drawn as.
+			enum Primitive {POINTS, LINES, LINE_STRIP, LINE_LOOP, TRIANGLE_STRIP, QUADS};
+			///Vertex layouts, the same as OpenGL interleaved arrays formats.
+			enum Format {V3F, C4UB_V3F, T2F_V3F, T2F_C4UB_V3F};
+			///Vertex of V3F format.
+			struct PosVertex
+				{
+				///Position.
+				float x, y, z;
+				};
+			///Vertex of C4UB_V3F format.
+			struct ColorVertex
+				{
+				///RGBA color.
+				unsigned char color[4];
+				///Position.
+				float x, y, z;
+				};
+			///Vertex of T2F_V3F format (see also CuboidMesh::Vertex).
+			struct TexVertex
+				{
+				///Texture coordinates.
+				float s, t;
+				///Position.
+				float x, y, z;
+				};
+			///Vertex of T2F_C4UB_V3F format (see also CubeBatch::Vertex).
+			struct TexColorVertex
+				{
+				///Texture coordinates.
+				float s, t;
+				///RGBA color.
+				unsigned char color[4];
+				///Position.
+				float x, y, z;
+				};
+			///Returns the size of a single vertex.
+			///@param format Vertex format.
+			///@return Size of a vertex in bytes.
+			static int vertexSize(Format format);
+			///Virtual destructor.
+			virtual ~Renderer();
+			///Replaces the current matrix with the identity matrix.
+			virtual void loadIdentity() = 0;
+			///Saves the current matrix.
+			virtual void pushMatrix() = 0;
+			///Restores the last saved matrix.
+			virtual void popMatrix() = 0;
+			///Multiplies the current matrix by a translation matrix.
+			virtual void translate(float x, float y, float z) = 0;
+			///Multiplies the current matrix by a scaling matrix.
+			virtual void scale(float x, float y, float z) = 0;
+			///Multiplies the current matrix by a rotation matrix.
+			///@param angle Angle in degrees.
+			///@param x X coordinate of the rotation axis.
+			///@param y Y coordinate of the rotation axis.
+			///@param z Z coordinate of the rotation axis.
+			virtual void rotate(float angle, float x, float y, float z) = 0;
+			///Enables a state.
+			virtual void enable(Capability capability) = 0;
+			///Disables a state.
+			virtual void disable(Capability capability) = 0;
+			///Selects a texture for the textured vertices.
+			///@param index Number of the texture (see MyOGL::Textures::select()).
+			virtual void texture(int index) = 0;
+			///Sets the linear fog range (fog must be enabled to be seen).
+			virtual void fog(float start, float end) = 0;
+			///Sets the color of the vertices which have no color.
+			virtual void color(float red, float green, float blue, float alpha = 1.0) = 0;
+			///Sets the color of the vertices which have no color.
+			///@sa MyOGL::hsv2rgb()
+			void colorHSV(float hue, float saturation, float value, float alpha = 1.0);
+			///Draws a vertex array.
+			///@param primitive Primitives the vertices are drawn as.
+			///@param format Layout of the vertices.
+			///@param vertices Vertices array, it is not needed after the call.
+			///@param count Number of vertices.
+			virtual void draw(Primitive primitive, Format format, const void* vertices, int count) = 0;
+			///Keeps a vertex array in the renderer.
+			///Parameters are the same as in draw().
+			///@return Mesh identifier, never 0.
+			virtual int createMesh(Primitive primitive, Format format, const void* vertices, int count) = 0;
+			///Draws a mesh.
+			///@param mesh Mesh identifier returned by createMesh().
+			virtual void drawMesh(int mesh) = 0;
+			///Releases a mesh.
+			///@param mesh Mesh identifier returned by createMesh().
+			virtual void deleteMesh(int mesh) = 0;
+		};		//class Renderer
+
+//----------------------------------------------------------------------------
+
+	///Renderer which records the commands instead of drawing them.
+	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+	///@date Jul 2005-Mar 2006
+	///@par
+	///Commands are stored one after another in a single buffer (arena), the vertices of a draw
+	///right after its command. clear() only rewinds the buffer, so after the first few frames
+	///recording doesn't allocate memory at all. The recorder counts the commands of every type and
+	///the drawn vertices, which is enough to see how many draw calls and state changes a frame costs.
+	///@par
+	///Recorded commands can be read with first() and next():
+	///@code
+	///for(const RenderRecorder::Command* command = recorder.first(); command != 0; command = recorder.next(command))
+	///	if(command->type == RenderRecorder::DRAW)
+	///		//command->count vertices are at command->vertices()
+	///@endcode
+	///@note Recorder doesn't use OpenGL, it works without any window.
+	class RenderRecorder: public Renderer
+		{
+		public:
+			///Types of the recorded commands, one for every Renderer method.
+			enum CommandType {LOAD_IDENTITY, PUSH_MATRIX, POP_MATRIX, TRANSLATE, SCALE, ROTATE, ENABLE, DISABLE,
+				TEXTURE, FOG, COLOR, DRAW, CREATE_MESH, DRAW_MESH, DELETE_MESH, COMMAND_TYPES};
+			///Single recorded command.
+			struct Command
+				{
+				///Type of the command.
+				CommandType type;
+				///Size of the command in the buffer (with the vertices) in bytes.
+				int size;
+				///Numeric arguments: x, y, z of TRANSLATE and SCALE, angle, x, y, z of ROTATE,
+				///start, end of FOG and red, green, blue, alpha of COLOR.
+				float args[4];
+				///Capability of ENABLE and DISABLE, index of TEXTURE or mesh of the mesh commands.
+				int param;
+				///Primitive of DRAW and CREATE_MESH.
+				Renderer::Primitive primitive;
+				///Vertices format of DRAW and CREATE_MESH.
+				Renderer::Format format;
+				///Number of vertices of DRAW, CREATE_MESH and DRAW_MESH.
+				int count;
+				///Returns the vertices of DRAW or CREATE_MESH, they are stored right after the command.
+				const void* vertices() const	{return this + 1;}
+				};
+		private:
+			///Buffer of the recorded commands.
+			///Grows when needed, but is never made smaller.
+			std::vector<char> arena;
+			///Number of bytes of the arena used by the commands.
+			int used;
+			///Number of the commands of every type.
+			///@sa count()
+			int counts[COMMAND_TYPES];
+			///Number of the drawn vertices.
+			///@sa vertices()
+			int vertices_;
+			///Number of vertices of every mesh which wasn't deleted.
+			std::map<int, int> meshes;
+			///Identifier of the last created mesh.
+			int lastMesh;
+			///Adds a new command to the buffer.
+			///@param type Type of the command.
+			///@param extra Number of bytes needed after the command (for the vertices).
+			///@return Command with only type and size set, valid until the next command is added.
+			Command& add(CommandType type, int extra = 0);
+		public:
+			///Creates an empty recorder.
+			RenderRecorder();
+			///Forgets the recorded commands and zeroes the counters, call it before every frame.
+			///Meshes are kept.
+			void clear();
+			///Returns the first recorded command.
+			///@return Command or 0 if nothing was recorded.
+			const Command* first() const;
+			///Returns the command recorded after the given one.
+			///@return Command or 0 if the given one was the last one.
+			const Command* next(const Command* command) const;
+			///Returns the number of the recorded commands of the given type.
+			int count(CommandType type) const	{return counts[type];}
+			///Returns the number of all the recorded commands.
+			int commands() const;
+			///Returns the number of draw calls (DRAW and DRAW_MESH commands).
+			int draws() const	{return counts[DRAW] + counts[DRAW_MESH];}
+			///Returns the number of the vertices drawn by all the draw calls.
+			int vertices() const	{return vertices_;}
+			///Returns the number of state changes (ENABLE, DISABLE, TEXTURE and FOG commands).
+			int stateChanges() const	{return counts[ENABLE] + counts[DISABLE] + counts[TEXTURE] + counts[FOG];}
+			///Returns the number of bytes of the recorded commands.
+			int bytes() const	{return used;}
+			///Returns the number of the meshes created and not deleted.
+			int liveMeshes() const	{return static_cast<int>(meshes.size());}
+			void loadIdentity();
+			void pushMatrix();
+			void popMatrix();
+			void translate(float x, float y, float z);
+			void scale(float x, float y, float z);
+			void rotate(float angle, float x, float y, float z);
+			void enable(Capability capability);
+			void disable(Capability capability);
+			void texture(int index);
+			void fog(float start, float end);
+			void color(float red, float green, float blue, float alpha = 1.0);
+			void draw(Primitive primitive, Format format, const void* vertices, int count);
+			int createMesh(Primitive primitive, Format format, const void* vertices, int count);
+			void drawMesh(int mesh);
+			void deleteMesh(int mesh);
+		};		//class RenderRecorder
+
+//----------------------------------------------------------------------------
+
+	}		//namespace CuTe
+
+//----------------------------------------------------------------------------
+
+#endif
+
+//----------------------------------------------------------------------------
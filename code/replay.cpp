@@ -0,0 +1,158 @@
+//----------------------------------------------------------------------------
+
+///@file
+///ReplayRecorder and ReplayReader class definitions.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include <fstream>
+#include <iterator>
+#include <boost/lexical_cast.hpp>
+#include "engine.h"
+#include "replay.h"
+using namespace CuTe;
+using boost::lexical_cast;
+
+//----------------------------------------------------------------------------
+
+const std::string ReplayRecorder::MAGIC = "CuTeRpl";
+
+//----------------------------------------------------------------------------
+
+ReplayRecorder::ReplayRecorder(boost::uint64_t seed, int size, int depth, int blocksSet):
+	data_(MAGIC), lastTime(0), finished_(false)
+	{
+	writeVarint(data_, VERSION);
+	writeVarint(data_, seed);
+	writeVarint(data_, size);
+	writeVarint(data_, depth);
+	writeVarint(data_, blocksSet);
+	}
+
+void ReplayRecorder::writeVarint(std::string& stream, boost::uint64_t value)
+	{
+	while(value >= 0x80)
+		{
+		stream += static_cast<char>((value & 0x7F) | 0x80);
+		value >>= 7;
+		}
+	stream += static_cast<char>(value);
+	}
+
+void ReplayRecorder::event(int code, int argument)
+	{
+	if(finished_)
+		return;
+	const int now = timer;
+	writeVarint(data_, (static_cast<boost::uint64_t>(now - lastTime) << EVENT_BITS) | code);
+	lastTime = now;
+	if(code == POINTS_MUL)
+		writeVarint(data_, argument);
+	}
+
+void ReplayRecorder::finish(int points)
+	{
+	event(END);
+	writeVarint(data_, points);
+	finished_ = true;
+	}
+
+void ReplayRecorder::save(const std::string& fileName) const
+	{
+	std::ofstream file(fileName.c_str(), std::ios::binary);
+	if(!file.write(data_.data(), data_.size()))
+		throw CuTeEx("Can't save replay file \"" + fileName + '"');
+	}
+
+//----------------------------------------------------------------------------
+
+ReplayReader::ReplayReader(const std::string& stream):
+	data(stream), position(ReplayRecorder::MAGIC.length()), time_(0), points_(-1), events_(0)
+	{
+	if(data.compare(0, ReplayRecorder::MAGIC.length(), ReplayRecorder::MAGIC) != 0)
+		throw CuTeEx("Not a CuTe replay");
+	const int version = readVarint();
+	if(version != ReplayRecorder::VERSION)
+		throw CuTeEx("Unsupported replay version: " + lexical_cast<std::string>(version));
+	seed_ = readVarint();
+	size_ = readVarint();
+	depth_ = readVarint();
+	blocksSet_ = readVarint();
+	}
+
+std::string ReplayReader::load(const std::string& fileName)
+	{
+	std::ifstream file(fileName.c_str(), std::ios::binary);
+	if(!file)
+		throw CuTeEx("Can't open replay file \"" + fileName + '"');
+	return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+boost::uint64_t ReplayReader::readVarint()
+	{
+	boost::uint64_t value = 0;
+	for(int shift = 0; shift < 64; shift += 7)
+		{
+		if(position >= data.size())
+			throw CuTeEx("Replay stream ends unexpectedly");
+		const unsigned char byte = data[position++];
+		value |= static_cast<boost::uint64_t>(byte & 0x7F) << shift;
+		if((byte & 0x80) == 0)
+			return value;
+		}
+	throw CuTeEx("Bad varint in replay stream");
+	}
+
+bool ReplayReader::step(Engine& engine)
+	{
+	if((points_ >= 0) || (position >= data.size()))
+		return false;		//finished (or not finished, but cut) recording
+	const boost::uint64_t event = readVarint();
+	time_ += static_cast<int>(event >> ReplayRecorder::EVENT_BITS);
+	switch(static_cast<int>(event & ((1 << ReplayRecorder::EVENT_BITS) - 1)))
+		{
+		case ReplayRecorder::MOVE_LEFT: engine.moveLeft(); break;
+		case ReplayRecorder::MOVE_RIGHT: engine.moveRight(); break;
+		case ReplayRecorder::MOVE_UP: engine.moveUp(); break;
+		case ReplayRecorder::MOVE_DOWN: engine.moveDown(); break;
+		case ReplayRecorder::MOVE_FORWARD: engine.moveForward(); break;
+		case ReplayRecorder::ROTATE_XCW: engine.rotateXCW(); break;
+		case ReplayRecorder::ROTATE_XCCW: engine.rotateXCCW(); break;
+		case ReplayRecorder::ROTATE_YCW: engine.rotateYCW(); break;
+		case ReplayRecorder::ROTATE_YCCW: engine.rotateYCCW(); break;
+		case ReplayRecorder::ROTATE_ZCW: engine.rotateZCW(); break;
+		case ReplayRecorder::ROTATE_ZCCW: engine.rotateZCCW(); break;
+		case ReplayRecorder::POINTS_MUL: engine.pointsMul(static_cast<int>(readVarint())); break;
+		case ReplayRecorder::CHEAT: engine.cheat(); break;
+		case ReplayRecorder::END:
+			points_ = static_cast<int>(readVarint());
+			return false;
+		default: throw CuTeEx("Bad replay event code");
+		}
+	++events_;
+	return true;
+	}
+
+//----------------------------------------------------------------------------
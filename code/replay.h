@@ -0,0 +1,210 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Recording and replaying games.
+///
+///@par Replay format:
+///All the numbers are unsigned varints (7 bits per byte, lowest first, highest bit set in all but
+///the last byte).
+///@verbatim
+///"CuTeRpl" VERSION seed size depth blocksSet
+///event*
+///@endverbatim
+///Every event is a varint (delta << EVENT_BITS) | code, where delta is the time (in ms) since the
+///previous event. ReplayRecorder::POINTS_MUL event is followed by the multiplier and
+///ReplayRecorder::END event by the points scored in the game.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+//----------------------------------------------------------------------------
+
+#include <string>
+#include <boost/cstdint.hpp>
+#include "MyOGL/timer.h"
+
+//----------------------------------------------------------------------------
+
+namespace CuTe
+	{
+
+//----------------------------------------------------------------------------
+
+	class Engine;		//forward declaration
+
+//----------------------------------------------------------------------------
+
+	///Records the game played by the Engine.
+	///@par
+	///Only the engine inputs are recorded (block moves and rotations, forward moves done by the
+	///player or by the game timer, points multiplier changes and cheats). The blocks sequence
+	///depends only on the seed (see Engine::seed()), so the inputs are enough to play exactly the
+	///same game again.
+	///@sa Engine::record()
+	///@sa ReplayReader
+	class ReplayRecorder
+		{
+		public:
+			///Block moved left.
+			static const int MOVE_LEFT = 0;
+			///Block moved right.
+			static const int MOVE_RIGHT = 1;
+			///Block moved up.
+			static const int MOVE_UP = 2;
+			///Block moved down.
+			static const int MOVE_DOWN = 3;
+			///Block moved forward.
+			static const int MOVE_FORWARD = 4;
+			///Block rotated around X axis clockwise.
+			static const int ROTATE_XCW = 5;
+			///Block rotated around X axis counterclockwise.
+			static const int ROTATE_XCCW = 6;
+			///Block rotated around Y axis clockwise.
+			static const int ROTATE_YCW = 7;
+			///Block rotated around Y axis counterclockwise.
+			static const int ROTATE_YCCW = 8;
+			///Block rotated around Z axis clockwise.
+			static const int ROTATE_ZCW = 9;
+			///Block rotated around Z axis counterclockwise.
+			static const int ROTATE_ZCCW = 10;
+			///Points multiplier changed, the multiplier follows.
+			static const int POINTS_MUL = 11;
+			///Player cheated.
+			static const int CHEAT = 12;
+			///Recording finished, the points follow.
+			static const int END = 15;
+			///Number of bits of the event code.
+			static const int EVENT_BITS = 4;
+			///Format version.
+			static const int VERSION = 1;
+			///Text at the beginning of every replay.
+			static const std::string MAGIC;
+
+			///Starts recording.
+			///@param seed Seed of the blocks generator.
+			///@param size Cuboid size.
+			///@param depth Cuboid depth.
+			///@param blocksSet Blocks set.
+			ReplayRecorder(boost::uint64_t seed, int size, int depth, int blocksSet);
+			///Records an event.
+			///@param code Event code, one of MOVE_LEFT ... CHEAT.
+			///@param argument Multiplier of POINTS_MUL event, ignored otherwise.
+			void event(int code, int argument = 0);
+			///Finishes recording; no events can be recorded any more.
+			///@param points Points scored, checked when replaying.
+			void finish(int points);
+			///Returns true if the recording is finished.
+			bool finished() const	{return finished_;}
+			///Returns the recorded stream.
+			const std::string& data() const	{return data_;}
+			///Saves the recorded stream in a file.
+			///@throws CuTeEx when the file can't be created.
+			void save(const std::string& fileName) const;
+			///Appends a varint to a stream.
+			static void writeVarint(std::string& stream, boost::uint64_t value);
+		private:
+			///Recorded stream.
+			std::string data_;
+			///Time since the recording started.
+			MyOGL::Timer timer;
+			///Time of the previous event.
+			int lastTime;
+			///True if the recording is finished.
+			///@sa finish()
+			bool finished_;
+		};		//class ReplayRecorder
+
+//----------------------------------------------------------------------------
+
+	///Reads the recorded game and plays it again.
+	///@sa ReplayRecorder
+	class ReplayReader
+		{
+		private:
+			///Whole replay stream.
+			std::string data;
+			///Position of the next byte to read.
+			std::string::size_type position;
+			///Seed of the blocks generator.
+			boost::uint64_t seed_;
+			///Cuboid size.
+			int size_;
+			///Cuboid depth.
+			int depth_;
+			///Blocks set.
+			int blocksSet_;
+			///Recorded time of the last event read (in ms since the recording started).
+			int time_;
+			///Recorded points, -1 until the END event is read.
+			int points_;
+			///Number of events played.
+			int events_;
+			///Reads a varint.
+			///@throws CuTeEx when the stream ends in the middle.
+			boost::uint64_t readVarint();
+		public:
+			///Reads the replay header.
+			///@param stream Whole replay stream, as ReplayRecorder::data() returns it.
+			///@throws CuTeEx when the stream isn't a replay.
+			explicit ReplayReader(const std::string& stream);
+			///Loads the replay from a file.
+			///@throws CuTeEx when the file can't be read or it isn't a replay.
+			static std::string load(const std::string& fileName);
+			///Returns the seed of the blocks generator.
+			boost::uint64_t seed() const	{return seed_;}
+			///Returns the cuboid size.
+			int size() const	{return size_;}
+			///Returns the cuboid depth.
+			int depth() const	{return depth_;}
+			///Returns the blocks set.
+			int blocksSet() const	{return blocksSet_;}
+			///Returns the recorded time (in ms) of the last event played.
+			int time() const	{return time_;}
+			///Returns the recorded points or -1 if the recording wasn't finished.
+			int points() const	{return points_;}
+			///Returns the number of events played.
+			int events() const	{return events_;}
+			///Plays the next event.
+			///@param engine Engine created with the seed and difficulty of the replay.
+			///@return False if there are no events left.
+			///@throws CuTeEx when the stream is broken.
+			bool step(Engine& engine);
+			///Plays all the remaining events.
+			///@param engine Engine created with the seed and difficulty of the replay.
+			///@throws CuTeEx when the stream is broken.
+			void play(Engine& engine)	{while(step(engine));}
+		};		//class ReplayReader
+
+//----------------------------------------------------------------------------
+
+	}		//namespace CuTe
+
+//----------------------------------------------------------------------------
+
+#endif		//#define REPLAY_H
+
+//----------------------------------------------------------------------------
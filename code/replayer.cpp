@@ -0,0 +1,121 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Headless replays player.
+///
+///Plays recorded games (see Engine::record()) at full speed and checks whether the points scored
+///are the same as recorded.
+///@par Usage:
+///@verbatim
+///cute-replay FILE...
+///@endverbatim
+///Exit code is 0 if all the replays match, 1 otherwise.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include <iostream>
+#include <iomanip>
+#include <boost/lexical_cast.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include "engine.h"
+using namespace CuTe;
+using boost::lexical_cast;
+
+//----------------------------------------------------------------------------
+
+namespace
+	{
+
+	///Engine driven by the replay.
+	class ReplayGame: public Engine
+		{
+		private:
+			///True if the game is over.
+			bool over_;
+		protected:
+			///Marks the game as over.
+			void gameOver()	{over_ = true;}
+		public:
+			///Creates the game with the replay seed.
+			ReplayGame(const Difficulty& difficulty, boost::uint64_t seed): Engine(difficulty, seed), over_(false)	{}
+			///Returns true if the game is over.
+			bool over() const	{return over_;}
+		};
+
+	///Plays a single replay.
+	///@return True if the points match.
+	bool play(const std::string& fileName)
+		{
+		ReplayReader replay(ReplayReader::load(fileName));
+		MyXML::Key diffData;
+		diffData.attribute("size") = lexical_cast<std::string>(replay.size());
+		diffData.attribute("depth") = lexical_cast<std::string>(replay.depth());
+		diffData.attribute("blocksSet") = lexical_cast<std::string>(replay.blocksSet());
+		Difficulty difficulty(diffData);
+		ReplayGame game(difficulty, replay.seed());
+		const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+		replay.play(game);
+		const double time = std::max(1e-6,
+			(boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e3);
+		const bool match = (replay.points() == static_cast<int>(game.points()));
+		std::cout << fileName << ": " << replay.size() << 'x' << replay.depth() << ", set " << replay.blocksSet() <<
+			", seed " << replay.seed() << ", " << replay.events() << " events, recorded " << replay.time() <<
+			" ms, replayed " << std::fixed << std::setprecision(2) << time << " ms (" << std::setprecision(0) <<
+			replay.time() / time << "x), points " << static_cast<int>(game.points());
+		if(replay.points() < 0)
+			std::cout << ", NOT FINISHED" << std::endl;
+		else if(match)
+			std::cout << ", OK" << std::endl;
+		else
+			std::cout << ", MISMATCH (recorded " << replay.points() << ")" << std::endl;
+		return match;
+		}
+
+	}
+
+//----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+	{
+	if(argc < 2)
+		{
+		std::cerr << "Usage: cute-replay FILE..." << std::endl;
+		return 1;
+		}
+	bool allMatch = true;
+	for(int i = 1; i < argc; ++i)
+		try
+			{
+			allMatch = play(argv[i]) && allMatch;
+			}
+		catch(const std::exception& e)
+			{
+			std::cerr << argv[i] << ": " << e.what() << std::endl;
+			allMatch = false;
+			}
+	return allMatch? 0 : 1;
+	}
+
+//----------------------------------------------------------------------------
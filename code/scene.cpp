@@ -43,6 +43,7 @@ MyOGL::Window("CuTe (C) 2005-06 Tomasz Nurkiewicz",
 		MyOGL::TEXTURES | MyOGL::BITMAP_FONTS | MyOGL::FPS_COUNTER | MyOGL::OUTLINE_FONTS),
 		mode_(iMode)
 	{
+	vsync(true);
 	initGL();
 	}
 
@@ -60,62 +61,85 @@ void CuTeWindow::initGL()
 
 //----------------------------------------------------------------------------
 
-void CuTeScene::drawCubeWallX(double x, double y, double z, double scale)
+///Sets all the values of a vertex.
+static void setVertex(Renderer::TexVertex& vertex, float s, float t, double x, double y, double z)
+	{
+	vertex.s = s;
+	vertex.t = t;
+	vertex.x = x;
+	vertex.y = y;
+	vertex.z = z;
+	}
+
+void CuTeScene::wallX(double x, double y, double z, double scale, Renderer::TexVertex strip[4])
 	{
 	x *= scale;
 	y = (y + 0.5) * scale;
 	z = (z + 0.5) * scale;
-	glBegin(GL_TRIANGLE_STRIP);		//right or left wall
-	glTexCoord2f(1.0, 1.0);
-	glVertex3f(x, y, z);
-	glTexCoord2f(0.0, 1.0);
-	glVertex3f(x, y, z - scale);
-	glTexCoord2f(1.0, 0.0);
-	glVertex3f(x, y - scale, z);
-	glTexCoord2f(0.0, 0.0);
-	glVertex3f(x, y - scale, z - scale);
-	glEnd();
+	setVertex(strip[0], 1.0, 1.0, x, y, z);		//right or left wall
+	setVertex(strip[1], 0.0, 1.0, x, y, z - scale);
+	setVertex(strip[2], 1.0, 0.0, x, y - scale, z);
+	setVertex(strip[3], 0.0, 0.0, x, y - scale, z - scale);
 	}
 
-void CuTeScene::drawCubeWallY(double x, double y, double z, double scale)
+void CuTeScene::wallY(double x, double y, double z, double scale, Renderer::TexVertex strip[4])
 	{
 	x = (x + 0.5) * scale;
 	y *= scale;
 	z = (z + 0.5) * scale;
-	glBegin(GL_TRIANGLE_STRIP);		//top and bottom wall
-	glTexCoord2f(1.0, 1.0);
-	glVertex3f(x, y, z - scale);
-	glTexCoord2f(0.0, 1.0);
-	glVertex3f(x - scale, y, z - scale);
-	glTexCoord2f(1.0, 0.0);
-	glVertex3f(x, y, z);
-	glTexCoord2f(0.0, 0.0);
-	glVertex3f(x - scale, y, z);
-	glEnd();
+	setVertex(strip[0], 1.0, 1.0, x, y, z - scale);		//top and bottom wall
+	setVertex(strip[1], 0.0, 1.0, x - scale, y, z - scale);
+	setVertex(strip[2], 1.0, 0.0, x, y, z);
+	setVertex(strip[3], 0.0, 0.0, x - scale, y, z);
+	}
+
+void CuTeScene::wallZ(double x, double y, double z, double scale, Renderer::TexVertex strip[4])
+	{
+	setVertex(strip[0], 1.0, 1.0, (x + 0.5) * scale, (y + 0.5) * scale, z * scale);		//front or back wall
+	setVertex(strip[1], 0.0, 1.0, (x - 0.5) * scale, (y + 0.5) * scale, z * scale);
+	setVertex(strip[2], 1.0, 0.0, (x + 0.5) * scale, (y - 0.5) * scale, z * scale);
+	setVertex(strip[3], 0.0, 0.0, (x - 0.5) * scale, (y - 0.5) * scale, z * scale);
+	}
+
+void CuTeScene::drawCubeWallX(double x, double y, double z, double scale) const
+	{
+	Renderer::TexVertex strip[4];
+	wallX(x, y, z, scale, strip);
+	renderer_.draw(Renderer::TRIANGLE_STRIP, Renderer::T2F_V3F, strip, 4);
+	}
+
+void CuTeScene::drawCubeWallY(double x, double y, double z, double scale) const
+	{
+	Renderer::TexVertex strip[4];
+	wallY(x, y, z, scale, strip);
+	renderer_.draw(Renderer::TRIANGLE_STRIP, Renderer::T2F_V3F, strip, 4);
 	}
 
-void CuTeScene::drawCubeWallZ(double x, double y, double z, double scale)
+void CuTeScene::drawCubeWallZ(double x, double y, double z, double scale) const
 	{
-	glBegin(GL_TRIANGLE_STRIP);		//front or back wall
-	glTexCoord2f(1.0, 1.0);
-	glVertex3f((x + 0.5) * scale, (y + 0.5) * scale, z * scale);
-	glTexCoord2f(0.0, 1.0);
-	glVertex3f((x - 0.5) * scale, (y + 0.5) * scale, z * scale);
-	glTexCoord2f(1.0, 0.0);
-	glVertex3f((x + 0.5) * scale, (y - 0.5) * scale, z * scale);
-	glTexCoord2f(0.0, 0.0);
-	glVertex3f((x - 0.5) * scale, (y - 0.5) * scale, z * scale);
-	glEnd();
+	Renderer::TexVertex strip[4];
+	wallZ(x, y, z, scale, strip);
+	renderer_.draw(Renderer::TRIANGLE_STRIP, Renderer::T2F_V3F, strip, 4);
 	}
 
-void CuTeScene::drawCube(double x, double y, double z, double scale)
+void CuTeScene::drawCube(double x, double y, double z, double scale) const
 	{
-	drawCubeWallX(x - 0.5, y, z, scale);
-	drawCubeWallX(x + 0.5, y, z, scale);
-	drawCubeWallY(x, y - 0.5, z, scale);
-	drawCubeWallY(x, y + 0.5, z, scale);
-	drawCubeWallZ(x, y, z - 0.5, scale);
-	drawCubeWallZ(x, y, z + 0.5, scale);
+	Renderer::TexVertex strips[6][4];
+	wallX(x - 0.5, y, z, scale, strips[0]);
+	wallX(x + 0.5, y, z, scale, strips[1]);
+	wallY(x, y - 0.5, z, scale, strips[2]);
+	wallY(x, y + 0.5, z, scale, strips[3]);
+	wallZ(x, y, z - 0.5, scale, strips[4]);
+	wallZ(x, y, z + 0.5, scale, strips[5]);
+	Renderer::TexVertex quads[6][4];
+	for(int wall = 0; wall < 6; ++wall)
+		{
+		quads[wall][0] = strips[wall][0];		//the last two vertices of a strip are swapped in a quad
+		quads[wall][1] = strips[wall][1];
+		quads[wall][2] = strips[wall][3];
+		quads[wall][3] = strips[wall][2];
+		}
+	renderer_.draw(Renderer::QUADS, Renderer::T2F_V3F, quads, 6 * 4);		//all the walls at once
 	}
 
 //----------------------------------------------------------------------------
@@ -36,6 +36,7 @@
 
 #include <boost/array.hpp>
 #include "MyOGL/scene.h"
+#include "glrenderer.h"
 #include "point.h"
 
 //----------------------------------------------------------------------------
@@ -98,45 +99,62 @@ namespace CuTe
 	///simple MyOGL::Window.
 	class CuTeScene: public MyOGL::Scene
 		{
+		private:
+			///Renderer the scene draws the cubes with.
+			///@sa renderer()
+			mutable GLRenderer renderer_;
+			///Puts the vertices of a cube wall orthogonal to the X axis into a triangle strip.
+			///Parameters are the same as in drawCubeWallX().
+			///@param strip Four vertices of the wall.
+			static void wallX(double x, double y, double z, double scale, Renderer::TexVertex strip[4]);
+			///Puts the vertices of a cube wall orthogonal to the Y axis into a triangle strip.
+			///@sa wallX()
+			static void wallY(double x, double y, double z, double scale, Renderer::TexVertex strip[4]);
+			///Puts the vertices of a cube wall orthogonal to the Z axis into a triangle strip.
+			///@sa wallX()
+			static void wallZ(double x, double y, double z, double scale, Renderer::TexVertex strip[4]);
 		public:
 			///Creates a new scene.
 			///This construcotr doesn't do anything particulary important - it only calls
 			///the base class constructor and saves the win reference to store tha parent window.
-			CuTeScene(CuTeWindow& parentWindow): MyOGL::Scene(parentWindow), win(parentWindow)	{}
+			CuTeScene(CuTeWindow& parentWindow): MyOGL::Scene(parentWindow),
+				renderer_(parentWindow.extensions()), win(parentWindow)	{}
+			///Returns the renderer the scene draws with.
+			Renderer& renderer() const	{return renderer_;}
 			///Draws a cube wall orthogonal to the X axis.
 			///@param x X coordinate of the center of the wall.
 			///@param y Y coordinate of the center of the wall.
 			///@param z Z coordinate of the center of the wall.
 			///@param scale Length of a wall border.
 			///@sa drawCube()
-			static void drawCubeWallX(double x, double y, double z, double scale = 1.0);
+			void drawCubeWallX(double x, double y, double z, double scale = 1.0) const;
 			///Draws a cube wall orthogonal to the Y axis.
 			///@param x X coordinate of the center of the wall.
 			///@param y Y coordinate of the center of the wall.
 			///@param z Z coordinate of the center of the wall.
 			///@param scale Length of a wall border.
 			///@sa drawCube()
-			static void drawCubeWallY(double x, double y, double z, double scale = 1.0);
+			void drawCubeWallY(double x, double y, double z, double scale = 1.0) const;
 			///Draws a cube wall orthogonal to the Z axis.
 			///@param x X coordinate of the center of the wall.
 			///@param y Y coordinate of the center of the wall.
 			///@param z Z coordinate of the center of the wall.
 			///@param scale Length of a wall border.
 			///@sa drawCube()
-			static void drawCubeWallZ(double x, double y, double z, double scale = 1.0);
+			void drawCubeWallZ(double x, double y, double z, double scale = 1.0) const;
 			///Draws a cube.
-			///Draws all the 6 cube walls by calling the appriopriate functions.
+			///Draws all the 6 cube walls at once.
 			///@param x X coordinate of the center of a cube.
 			///@param y Y coordinate of the center of a cube.
 			///@param z Z coordinate of the center of a cube.
 			///@param scale Length of a wall border.
 			///@sa drawCubeWallX(), drawCubeWallY(), drawCubeWallZ()
-			static void drawCube(double x, double y, double z, double scale = 1.0);
+			void drawCube(double x, double y, double z, double scale = 1.0) const;
 			///Draws a cube.
 			///@param pos Position (in 3D) of the center of a cube.
 			///@param scale Length of a wall border.
 			///@sa drawCube(double x, double y, double z, double scale)
-			static void drawCube(const Point<double, 3>& pos, double scale = 1.0)
+			void drawCube(const Point<double, 3>& pos, double scale = 1.0) const
 				{drawCube(pos.x(), pos.y(), pos.z(), scale);}
 		protected:
 			///Parent CuTe window.
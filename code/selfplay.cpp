@@ -0,0 +1,68 @@
+//----------------------------------------------------------------------------
+
+///@file
+///SelfPlay class definitions.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include "selfplay.h"
+using namespace CuTe;
+
+//----------------------------------------------------------------------------
+
+SelfPlay::SelfPlay(const Difficulty& difficulty, int maxBlocks, boost::uint64_t seed):
+	Engine(difficulty, seed), analyzer_(*this, false), maxBlocks_(maxBlocks), blocks_(0), planes_(0), over_(false)
+	{
+	}
+
+void SelfPlay::removeFilledPlanes()
+	{
+	Engine::removeFilledPlanes();
+	for(int z = 0; z < depth(); ++z)
+		if(removedPlane(z))
+			++planes_;
+	}
+
+void SelfPlay::switchBlocks()
+	{
+	Engine::switchBlocks();
+	++blocks_;
+	}
+
+void SelfPlay::play()
+	{
+	analyzer_.process();		//start processing the first block
+	while(!over_ && (blocks_ < maxBlocks_))
+		{
+		if(analyzer_.state() == BlockAnalyzer::GAMEOVER)
+			over_ = true;		//block got stuck
+		else if(analyzer_.state() != BlockAnalyzer::IDLE)
+			analyzer_.process();
+		else if(!moveForward())
+			analyzer_.process();		//block was put, start processing the new one
+		}
+	}
+
+//----------------------------------------------------------------------------
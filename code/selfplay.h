@@ -0,0 +1,110 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Headless game played by BlockAnalyzer, used for tuning and benchmarks.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#ifndef SELFPLAY_H
+#define SELFPLAY_H
+
+//----------------------------------------------------------------------------
+
+#include "blockanalyzer.h"
+
+//----------------------------------------------------------------------------
+
+namespace CuTe
+	{
+
+//----------------------------------------------------------------------------
+
+	///Game played by the computer without any display.
+	///@par
+	///The analyzer moves and rotates every block to the best position found and the block is then
+	///pushed forward until it is put on a cuboid - as fast as possible, without waiting for the game
+	///speed. The game ends when it is over or after the given number of blocks.
+	///@par
+	///Every SelfPlay object is independent, so many games can be played at once by many threads
+	///(every thread playing its own game).
+	///@sa BlockAnalyzer
+	class SelfPlay: public Engine
+		{
+		private:
+			///Analyzer playing the game.
+			///@sa analyzer()
+			BlockAnalyzer analyzer_;
+			///Maximum number of blocks put in the game.
+			const int maxBlocks_;
+			///Number of blocks put so far.
+			///@sa blocks()
+			int blocks_;
+			///Number of planes removed so far.
+			///@sa planes()
+			int planes_;
+			///True if the game is over.
+			///@sa over()
+			bool over_;
+		protected:
+			///Counts the removed planes.
+			///@sa planes_
+			virtual void removeFilledPlanes();
+			///Counts the blocks put on a cuboid.
+			///@sa blocks_
+			virtual void switchBlocks();
+			///Marks the game as over.
+			///@sa over_
+			virtual void gameOver()	{over_ = true;}
+		public:
+			///Creates a new game.
+			///@param difficulty Game cuboid size, depth and blocks set.
+			///@param maxBlocks Number of blocks after which the game stops even if it isn't over.
+			///@param seed Seed of the blocks generator; games with the same seed and the same analyzer
+			///settings are exactly the same.
+			SelfPlay(const Difficulty& difficulty, int maxBlocks, boost::uint64_t seed = randomSeed());
+			///Returns the analyzer playing the game.
+			///It can be used to change the weights, threads or lookahead before play() is called.
+			BlockAnalyzer& analyzer()	{return analyzer_;}
+			///Plays the game till it is over or maxBlocks_ blocks are put.
+			///Game is also stopped when the analyzer gets stuck (BlockAnalyzer::GAMEOVER state).
+			void play();
+			///Returns the number of blocks put on a cuboid.
+			int blocks() const	{return blocks_;}
+			///Returns the number of planes removed.
+			int planes() const	{return planes_;}
+			///Returns true if the game is over (the block couldn't enter the cuboid or the analyzer
+			///got stuck), false if it was stopped after maxBlocks_ blocks.
+			bool over() const	{return over_;}
+		};		//class SelfPlay
+
+//----------------------------------------------------------------------------
+
+	}		//namespace CuTe
+
+//----------------------------------------------------------------------------
+
+#endif		//#define SELFPLAY_H
+
+//----------------------------------------------------------------------------
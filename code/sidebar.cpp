@@ -39,6 +39,26 @@ using boost::lexical_cast;
 
 //----------------------------------------------------------------------------
 
+namespace
+	{
+	///Returns a 2D vertex with color given in HSV model.
+	Renderer::ColorVertex vertex(float x, float y, float hue, float saturation, float value)
+		{
+		Renderer::ColorVertex point;
+		float rgb[3];
+		MyOGL::hsv2rgb(hue, saturation, value, rgb);
+		for(int c = 0; c < 3; ++c)
+			point.color[c] = static_cast<unsigned char>(rgb[c] * 255);
+		point.color[3] = 255;
+		point.x = x;
+		point.y = y;
+		point.z = 0.0;
+		return point;
+		}
+	}
+
+//----------------------------------------------------------------------------
+
 const float SideBar::FloatingBar::WIDTH = 0.1;
 const float SideBar::FloatingBar::HEIGHT = 0.7;
 const float SideBar::FloatingBar::MAX_POS = 1.0;
@@ -62,31 +82,27 @@ void SideBar::FloatingBar::set(float newPos)
 	shift += old - pos;
 	}
 
-void SideBar::FloatingBar::draw()
+void SideBar::FloatingBar::draw(Renderer& renderer)
 	{
 	update();		//update data before drawing
-	glPushMatrix();
-	glTranslatef(barPosX, barPosY, 0.0);
-	glRotatef(barAngleZ, 0.0, 0.0, 1.0);
-	glBegin(GL_LINE_LOOP);
-	glColorHSV(hue, 1.0, 0.6);
-	glVertex2f(-WIDTH / 2, -HEIGHT / 2);
-	glVertex2f(WIDTH / 2, -HEIGHT / 2);
-	glColorHSV(hue, 1.0, 0.12);
-	glVertex2f(WIDTH / 2, HEIGHT / 2);
-	glVertex2f(-WIDTH / 2, HEIGHT / 2);
-	glEnd();
-	glBegin(GL_QUADS);
-	glColorHSV(hue, 0.8, 0.8);
-	float height = -HEIGHT / 2 + 0.02;
-	glVertex2f(-WIDTH / 2 + 0.02, height);
-	glVertex2f(WIDTH / 2 - 0.02, height);
-	glColorHSV(hue, 0.8, 0.2);
-	height += 0.01 + (HEIGHT - 0.04) * (pos + shift) / MAX_POS;
-	glVertex2f(WIDTH / 2 - 0.02, height);
-	glVertex2f(-WIDTH / 2 + 0.02, height);
-	glEnd();
-	glPopMatrix();
+	renderer.pushMatrix();
+	renderer.translate(barPosX, barPosY, 0.0);
+	renderer.rotate(barAngleZ, 0.0, 0.0, 1.0);
+	const Renderer::ColorVertex frame[] = {
+		vertex(-WIDTH / 2, -HEIGHT / 2, hue, 1.0, 0.6),
+		vertex(WIDTH / 2, -HEIGHT / 2, hue, 1.0, 0.6),
+		vertex(WIDTH / 2, HEIGHT / 2, hue, 1.0, 0.12),
+		vertex(-WIDTH / 2, HEIGHT / 2, hue, 1.0, 0.12)};
+	renderer.draw(Renderer::LINE_LOOP, Renderer::C4UB_V3F, frame, 4);
+	const float bottom = -HEIGHT / 2 + 0.02;
+	const float top = bottom + 0.01 + (HEIGHT - 0.04) * (pos + shift) / MAX_POS;
+	const Renderer::ColorVertex bar[] = {
+		vertex(-WIDTH / 2 + 0.02, bottom, hue, 0.8, 0.8),
+		vertex(WIDTH / 2 - 0.02, bottom, hue, 0.8, 0.8),
+		vertex(WIDTH / 2 - 0.02, top, hue, 0.8, 0.2),
+		vertex(-WIDTH / 2 + 0.02, top, hue, 0.8, 0.2)};
+	renderer.draw(Renderer::QUADS, Renderer::C4UB_V3F, bar, 4);
+	renderer.popMatrix();
 	}
 
 //----------------------------------------------------------------------------
@@ -126,7 +142,8 @@ void SideBar::ScoreDisplay::update(int points)
 SideBar::SideBar(const Difficulty& difficulty, MyOGL::Extensions& iExtensions):
 	distBar(0.04, -0.6, -10.0, 0.0, 1.0),
 	forwardMoveBar(0.2, -0.55, -10.0, 2 * M_PI / 3, 4.0),
-	speedTimeBar(0.36, -0.5, -10.0, 4 * M_PI / 3, 0.3), extensions(iExtensions), scoreDisplay(extensions.outlineFonts()),
+	speedTimeBar(0.36, -0.5, -10.0, 4 * M_PI / 3, 0.3), extensions(iExtensions), renderer(extensions),
+	scoreDisplay(extensions.outlineFonts()),
 	sizeStr(lexical_cast<std::string>(difficulty.size()) + 'x' + lexical_cast<std::string>(difficulty.size()) + 'x' +
 		lexical_cast<std::string>(difficulty.depth()))
 	{
@@ -134,28 +151,24 @@ SideBar::SideBar(const Difficulty& difficulty, MyOGL::Extensions& iExtensions):
 
 void SideBar::drawBackground()
 	{
-	extensions.textures().enable();
-	extensions.textures().select(1);
-	glColorHSV(0.0, 0.0, 1.0);
-	glBegin(GL_QUADS);
-	glTexCoord2i(0, 0);
-	glVertex2f(-0.5, 0.0);
-	glTexCoord2i(1, 0);
-	glVertex2f(0.5, 0.0);
-	glTexCoord2i(1, 1);
-	glVertex2f(0.5, 1.0);
-	glTexCoord2i(0, 1);
-	glVertex2f(-0.5, 1.0);
-	glEnd();
-	extensions.textures().disable();
+	const Renderer::TexVertex logo[] = {
+		{0.0, 0.0, -0.5, 0.0, 0.0},
+		{1.0, 0.0, 0.5, 0.0, 0.0},
+		{1.0, 1.0, 0.5, 1.0, 0.0},
+		{0.0, 1.0, -0.5, 1.0, 0.0}};
+	renderer.enable(Renderer::TEXTURE);
+	renderer.texture(1);
+	renderer.color(1.0, 1.0, 1.0);
+	renderer.draw(Renderer::QUADS, Renderer::T2F_V3F, logo, 4);
+	renderer.disable(Renderer::TEXTURE);
 	}
 
 void SideBar::draw(const GameInfo &info)
 	{
 	drawBackground();		//CuTe logo
-	distBar.draw(info.dist);		//3 display bars
-	forwardMoveBar.draw(info.forwardMoveTime);
-	speedTimeBar.draw(info.speedChangeTime);
+	distBar.draw(renderer, info.dist);		//3 display bars
+	forwardMoveBar.draw(renderer, info.forwardMoveTime);
+	speedTimeBar.draw(renderer, info.speedChangeTime);
 	scoreDisplay.draw(info.points);
 	showOtherData(info.speed, info.gameTime);
 	}
@@ -37,6 +37,7 @@
 
 #include <string>
 #include "MyOGL/window.h"
+#include "glrenderer.h"
 #include "common.h"
 #include "difficulty.h"
 
@@ -126,14 +127,15 @@ namespace CuTe
 					///Draws the bar.
 					///The bar position and rotation are saved in the object and set just before drawing.
 					///Before drawing the bar the shift value is updated using update() private method.
+					///@param renderer Renderer to draw with.
 					///@sa update()
-					///@sa draw(float newPos)
-					void draw();
+					///@sa draw(Renderer& renderer, float newPos)
+					void draw(Renderer& renderer);
 					///Overloaded draw() version.
 					///This version of draw() method changes the bar position before drawing, which might
 					///save you some time while writing the program.
 					///@sa draw()
-					void draw(float newPos)	{set(newPos); draw();}
+					void draw(Renderer& renderer, float newPos)	{set(newPos); draw(renderer);}
 					///Sets the progress bar position.
 					///@param newPos New progress bar position. Should be in range <0.0; MAX_POS>
 					///which actually is <0.0; 1.0>. If your newPos will be lower than 0.0, position 0.0
@@ -206,6 +208,8 @@ namespace CuTe
 			///Reference to MyOGL::Extensions gives the side bar access to many MyOGL extensions
 			///such as textures, bitmap and outline fonts, etc.
 			MyOGL::Extensions& extensions;
+			///Renderer the bars and the logo are drawn with.
+			GLRenderer renderer;
 			///ScoreDisplay object.
 			///Score display is a part of a side bar so it is nested in the object.
 			///SideBar only needs to call ScoreDisplay::draw() method.
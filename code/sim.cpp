@@ -0,0 +1,255 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Batch games simulator.
+///
+///Plays headless games (SelfPlay) to the game over at full speed on many threads and reports the
+///throughput (games and blocks per second) and the distribution of points, removed planes and
+///blocks put. Every game uses its own seed and the analyzer has no time limits, so the results
+///don't depend on the number of threads nor on the speed of the machine.
+///@par Usage:
+///@verbatim
+///cute-sim [--size N] [--depth N] [--set N] [--seed N] [--games N] [--threads N]
+///         [--max-blocks N] [--lookahead N] [--rollouts N] [--record PREFIX]
+///@endverbatim
+///Games with seeds from seed to seed + games - 1 are played; game stopped after max-blocks blocks
+///(0 means no limit) counts as not finished. With --rollouts the analyzer uses N rollouts for every
+///placement (see BlockAnalyzer::rollouts()) and with --lookahead it searches N blocks deep (see
+///BlockAnalyzer::lookahead()), both with no time limit, so the results stay repeatable. With
+///--record every game is saved as a replay (see cute-replay) in file PREFIX<seed>.rpl.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <ctime>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <numeric>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/thread/thread.hpp>
+#include "difficulty.h"
+#include "selfplay.h"
+using namespace CuTe;
+using boost::lexical_cast;
+
+//----------------------------------------------------------------------------
+
+namespace
+	{
+
+	///Simulator settings given in the command line.
+	struct Options
+		{
+		///Cuboid size.
+		int size;
+		///Cuboid depth.
+		int depth;
+		///Blocks set.
+		int blocksSet;
+		///Seed of the first game; game n uses seed + n.
+		unsigned int seed;
+		///Number of games.
+		int games;
+		///Worker threads.
+		int threads;
+		///Blocks after which a game is stopped, 0 if there is no limit.
+		int maxBlocks;
+		///Analyzer lookahead plies.
+		///@sa BlockAnalyzer::lookahead()
+		int lookahead;
+		///Analyzer rollouts for every placement, 0 if rollouts aren't used.
+		///@sa BlockAnalyzer::rollouts()
+		int rollouts;
+		///Prefix of the replay files names, empty if games aren't recorded.
+		std::string record;
+		};
+
+	///Results of a single game.
+	struct Result
+		{
+		///Points.
+		int points;
+		///Removed planes.
+		int planes;
+		///Blocks put.
+		int blocks;
+		///True if the game was played to the game over.
+		bool over;
+		};
+
+	///Worker thread routine.
+	///Every thread plays its own shard of games (every threads-th game starting with shard), so the
+	///threads share nothing but the results vector, in which every game has its own element.
+	void playGames(std::vector<Result>& results, const Difficulty& difficulty, const Options& options, int shard)
+		{
+		const int maxBlocks = (options.maxBlocks > 0)? options.maxBlocks : std::numeric_limits<int>::max();
+		for(int g = shard; g < options.games; g += options.threads)
+			{
+			SelfPlay game(difficulty, maxBlocks, options.seed + g);
+			game.analyzer().lookahead(options.lookahead);
+			game.analyzer().rollouts(options.rollouts);
+			game.analyzer().rolloutTime(std::numeric_limits<int>::max());		//the same rollouts on every machine
+			game.analyzer().lookaheadTime(std::numeric_limits<int>::max());		//and the same lookahead search
+			if(!options.record.empty())
+				game.record();
+			game.play();
+			if(game.recorder() != NULL)
+				{
+				game.recorder()->finish(game.points());
+				game.recorder()->save(options.record + lexical_cast<std::string>(options.seed + g) + ".rpl");
+				}
+			results[g].points = game.points();
+			results[g].planes = game.planes();
+			results[g].blocks = game.blocks();
+			results[g].over = game.over();
+			}
+		}
+
+	///Prints the distribution of values.
+	///@param name Name of the values.
+	///@param values Values to describe; they are sorted.
+	void printDistribution(const std::string& name, std::vector<int>& values)
+		{
+		std::sort(values.begin(), values.end());
+		double sum = 0.0;
+		for(std::vector<int>::const_iterator i = values.begin(); i != values.end(); ++i)
+			sum += *i;
+		const int last = values.size() - 1;
+		std::cout << std::left << std::setw(8) << name << std::right << std::fixed << std::setprecision(1) <<
+			std::setw(12) << sum / values.size() << std::setw(10) << values.front() <<
+			std::setw(10) << values[last / 10] << std::setw(10) << values[last / 4] <<
+			std::setw(10) << values[last / 2] << std::setw(10) << values[last - last / 4] <<
+			std::setw(10) << values[last - last / 10] << std::setw(10) << values.back() << std::endl;
+		}
+
+	///Reads the command line options.
+	///@throws CuTeEx on unknown option or a missing value.
+	Options readOptions(int argc, char* argv[])
+		{
+		Options options = {Difficulty::SIZE_MIN, Difficulty::DEPTH_MIN, Difficulty::BLOCKS_SET_CLASSIC, 1, 100,
+			std::max(1, static_cast<int>(boost::thread::hardware_concurrency())), 0, 1, 0, ""};
+		for(int i = 1; i < argc; i += 2)
+			{
+			const std::string name = argv[i];
+			if(i + 1 >= argc)
+				throw CuTeEx("Missing value of option " + name);
+			const std::string value = argv[i + 1];
+			if(name == "--seed")
+				options.seed = lexical_cast<unsigned int>(value);
+			else if(name == "--record")
+				options.record = value;
+			else
+				{
+				int* target = NULL;
+				if(name == "--size")
+					target = &options.size;
+				else if(name == "--depth")
+					target = &options.depth;
+				else if(name == "--set")
+					target = &options.blocksSet;
+				else if(name == "--games")
+					target = &options.games;
+				else if(name == "--threads")
+					target = &options.threads;
+				else if(name == "--max-blocks")
+					target = &options.maxBlocks;
+				else if(name == "--lookahead")
+					target = &options.lookahead;
+				else if(name == "--rollouts")
+					target = &options.rollouts;
+				else
+					throw CuTeEx("Unknown option " + name);
+				*target = lexical_cast<int>(value);
+				}
+			}
+		options.games = std::max(1, options.games);
+		options.threads = std::max(1, std::min(options.threads, options.games));
+		options.maxBlocks = std::max(0, options.maxBlocks);
+		options.lookahead = std::max(1, options.lookahead);
+		options.rollouts = std::max(0, options.rollouts);
+		return options;
+		}
+
+	}
+
+//----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+	{
+	try
+		{
+		const Options options = readOptions(argc, argv);
+		MyXML::Key diffData;
+		Difficulty difficulty(diffData);
+		difficulty.size(options.size);
+		difficulty.depth(options.depth);
+		difficulty.blocksSet(options.blocksSet);
+		std::cout << "size " << difficulty.size() << ", depth " << difficulty.depth() << ", blocks set " <<
+			difficulty.blocksSet() << ", seeds " << options.seed << '-' << options.seed + options.games - 1 <<
+			", threads " << options.threads << std::endl;
+		std::vector<Result> results(options.games);
+		const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+		const std::clock_t cpuStart = std::clock();
+		boost::thread_group workers;
+		for(int t = 0; t < options.threads; ++t)
+			workers.create_thread(boost::bind(&playGames, boost::ref(results), boost::cref(difficulty),
+				boost::cref(options), t));
+		workers.join_all();
+		const double cpuTime = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+		const double time = std::max(1e-6,
+			(boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6);
+		std::vector<int> points, planes, blocks;
+		int over = 0;
+		for(std::vector<Result>::const_iterator i = results.begin(); i != results.end(); ++i)
+			{
+			points.push_back(i->points);
+			planes.push_back(i->planes);
+			blocks.push_back(i->blocks);
+			over += i->over;
+			}
+		const double allBlocks = std::accumulate(blocks.begin(), blocks.end(), 0.0);
+		std::cout << std::fixed << std::setprecision(2) << "time " << time << " s, CPU time " << cpuTime <<
+			" s, games over " << over << '/' << options.games << std::endl;
+		std::cout << "games/s " << options.games / time << ", blocks/s " << allBlocks / time <<
+			", blocks/CPU-s " << allBlocks / std::max(cpuTime, 1e-6) << std::endl;
+		std::cout << std::left << std::setw(8) << "" << std::right << std::setw(12) << "mean" << std::setw(10) <<
+			"min" << std::setw(10) << "10%" << std::setw(10) << "25%" << std::setw(10) << "median" <<
+			std::setw(10) << "75%" << std::setw(10) << "90%" << std::setw(10) << "max" << std::endl;
+		printDistribution("points", points);
+		printDistribution("planes", planes);
+		printDistribution("blocks", blocks);
+		}
+	catch(const std::exception& e)
+		{
+		std::cerr << e.what() << std::endl;
+		return 1;
+		}
+	return 0;
+	}
+
+//----------------------------------------------------------------------------
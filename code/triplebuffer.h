@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Lock-free triple buffer for handing data from one thread to another.
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+//----------------------------------------------------------------------------
+
+#include <vector>
+#include <boost/atomic.hpp>
+
+//----------------------------------------------------------------------------
+
+namespace CuTe
+	{
+
+//----------------------------------------------------------------------------
+
+	///Passes the latest value from one writer thread to one reader thread without locking.
+	///@par
+	///There are three copies of the value: the writer fills back() and publishes it, the reader
+	///reads front() and takes the newest published copy with update(). The third copy is the one
+	///published last and not taken yet; publish() and update() swap it atomically with their own.
+	///Thanks to that neither thread ever waits for the other one and the reader always sees
+	///a whole value, never a half written one. If the writer publishes faster than the reader
+	///takes, the older values are simply skipped.
+	///@par Example:
+	///@code
+	/// TripleBuffer<int> buffer(0);
+	/// //writer thread
+	/// buffer.back() = 42;
+	/// buffer.publish();
+	/// //reader thread
+	/// buffer.update();
+	/// std::cout << buffer.front();
+	///@endcode
+	///@note back() is left with some old value after publish(), so the writer should fill
+	///the whole value every time.
+	template<typename T>
+	class TripleBuffer
+		{
+		private:
+			///Flag set in middle when it holds the value which the reader hasn't taken yet.
+			static const int FRESH = 4;
+			///All three copies of the value.
+			std::vector<T> buffers;
+			///Index of the copy owned by the writer.
+			int back_;
+			///Index of the copy owned by the reader.
+			int front_;
+			///Index of the third copy (with FRESH flag).
+			boost::atomic<int> middle;
+			///Copying would break the ownership of the copies.
+			TripleBuffer(const TripleBuffer&);
+		public:
+			///Constructor.
+			///@param initial Value of all three copies, front() returns it until the first update().
+			TripleBuffer(const T& initial): buffers(3, initial), back_(0), front_(1), middle(2)	{}
+			///Returns the copy which the writer can fill.
+			T& back()	{return buffers[back_];}
+			///Makes the back() copy available to the reader.
+			///Should be called only by the writer thread.
+			void publish()	{back_ = middle.exchange(back_ | FRESH, boost::memory_order_acq_rel) & ~FRESH;}
+			///Takes the latest published copy as front().
+			///Should be called only by the reader thread.
+			///@return True if there was a new copy, false if front() is still the same.
+			bool update()
+				{
+				if(!(middle.load(boost::memory_order_relaxed) & FRESH))
+					return false;
+				front_ = middle.exchange(front_, boost::memory_order_acq_rel) & ~FRESH;
+				return true;
+				}
+			///Returns the copy taken by the last update().
+			const T& front() const	{return buffers[front_];}
+		};		//class TripleBuffer
+
+//----------------------------------------------------------------------------
+
+	}		//namespace CuTe
+
+//----------------------------------------------------------------------------
+
+#endif
+
+//----------------------------------------------------------------------------
@@ -0,0 +1,301 @@
+//----------------------------------------------------------------------------
+
+///@file
+///Self-play tuner of BlockAnalyzer weights.
+///
+///Plays many headless games (SelfPlay) on all the processors and looks for the heights,
+///distances and edges weights giving the most points using a simple evolution strategy. The best
+///weights are saved as the profile for the chosen cuboid size and blocks set (see
+///BlockAnalyzer::saveWeights()), so BlockAnalyzer uses them from now on.
+///@par Usage:
+///@verbatim
+///cute-tune [--size N] [--depth N] [--set N] [--games N] [--generations N] [--population N]
+///          [--threads N] [--max-blocks N] [--seed N] [--output FILE]
+///@endverbatim
+///
+///@par License:
+///@verbatim
+///CuTe - Cubic Tetris, OpenGL 3D Tetris game clone.
+///Copyright (C) 2005-06 Tomasz Nurkiewicz
+///For full license text see license.txt.
+///
+///This program is free software; you can redistribute it and/or modify it under the terms of
+///the GNU General Public License as published by the Free Software Foundation;
+///either version 2 of the License, or (at your option) any later version.
+///
+///This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+///without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+///See the GNU General Public License for more details.
+///
+///You should have received a copy of the GNU General Public License along with this program;
+///if not, write to the Free Software Foundation, Inc.,
+///59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+///@endverbatim
+///
+///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+///@date Jul 2005-Mar 2006
+
+//----------------------------------------------------------------------------
+
+#include <cmath>
+#include <ctime>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/thread/thread.hpp>
+#include "difficulty.h"
+#include "selfplay.h"
+using namespace CuTe;
+using boost::lexical_cast;
+
+//----------------------------------------------------------------------------
+
+namespace
+	{
+
+	///Tuner settings given in the command line.
+	struct Options
+		{
+		///Cuboid size.
+		int size;
+		///Cuboid depth.
+		int depth;
+		///Blocks set.
+		int blocksSet;
+		///Games played by every candidate.
+		int games;
+		///Number of generations.
+		int generations;
+		///Candidates in every generation.
+		int population;
+		///Worker threads.
+		int threads;
+		///Blocks after which a game is stopped.
+		int maxBlocks;
+		///Seed of the first game; game n uses seed + n.
+		unsigned int seed;
+		///File to save the best weights in.
+		std::string output;
+		};
+
+	///Analyzer weights with their results.
+	struct Candidate
+		{
+		///Heights, distances and edges weights.
+		int weights[3];
+		///Sum of points in all the games.
+		double points;
+		///Sum of removed planes in all the games.
+		double planes;
+		///Sum of blocks put in all the games.
+		double blocks;
+		///Mean points per game, used to compare the candidates.
+		double fitness() const	{return points;}
+		};
+
+	///Compares candidates, better first.
+	bool better(const Candidate& left, const Candidate& right)
+		{
+		return left.fitness() > right.fitness();
+		}
+
+	///Games to play shared by the worker threads.
+	struct Jobs
+		{
+		///Candidates to evaluate.
+		std::vector<Candidate>* candidates;
+		///Game settings.
+		const Difficulty* difficulty;
+		///Tuner settings.
+		const Options* options;
+		///Index of the next job (candidate * games + game).
+		int next;
+		///Mutex guarding next and the candidate results.
+		boost::mutex mutex;
+		};
+
+	///Worker thread routine: plays the games until there are none left.
+	void playGames(Jobs& jobs)
+		{
+		const int count = jobs.candidates->size() * jobs.options->games;
+		for(;;)
+			{
+			int job;
+				{
+				boost::mutex::scoped_lock lock(jobs.mutex);
+				job = jobs.next++;
+				}
+			if(job >= count)
+				return;
+			Candidate& candidate = (*jobs.candidates)[job / jobs.options->games];
+			//all the candidates play the same games
+			SelfPlay game(*jobs.difficulty, jobs.options->maxBlocks, jobs.options->seed + job % jobs.options->games);
+			game.analyzer().weights(candidate.weights[0], candidate.weights[1], candidate.weights[2]);
+			game.play();
+			boost::mutex::scoped_lock lock(jobs.mutex);
+			candidate.points += static_cast<int>(game.points());
+			candidate.planes += game.planes();
+			candidate.blocks += game.blocks();
+			}
+		}
+
+	///Plays all the games of all the candidates.
+	///@return CPU time used (in seconds).
+	double evaluate(std::vector<Candidate>& candidates, const Difficulty& difficulty, const Options& options)
+		{
+		for(std::vector<Candidate>::iterator i = candidates.begin(); i != candidates.end(); ++i)
+			i->points = i->planes = i->blocks = 0.0;
+		Jobs jobs;
+		jobs.candidates = &candidates;
+		jobs.difficulty = &difficulty;
+		jobs.options = &options;
+		jobs.next = 0;
+		const std::clock_t start = std::clock();
+		boost::thread_group workers;
+		for(int t = 0; t < options.threads; ++t)
+			workers.create_thread(boost::bind(&playGames, boost::ref(jobs)));
+		workers.join_all();
+		for(std::vector<Candidate>::iterator i = candidates.begin(); i != candidates.end(); ++i)
+			{
+			i->points /= options.games;
+			i->planes /= options.games;
+			i->blocks /= options.games;
+			}
+		return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+		}
+
+	///Prints the candidate weights and results.
+	void print(const Candidate& candidate)
+		{
+		std::cout << std::setw(6) << candidate.weights[0] << std::setw(7) << candidate.weights[1] <<
+			std::setw(5) << candidate.weights[2] << "  points " << std::setw(10) << std::fixed <<
+			std::setprecision(1) << candidate.points << "  planes " << std::setw(7) << candidate.planes <<
+			"  blocks " << std::setw(7) << candidate.blocks;
+		}
+
+	///Reads the command line options.
+	///@throws CuTeEx on unknown option or a missing value.
+	Options readOptions(int argc, char* argv[])
+		{
+		Options options = {Difficulty::SIZE_MIN, Difficulty::DEPTH_MIN, Difficulty::BLOCKS_SET_CLASSIC, 20, 10, 12,
+			std::max(1, static_cast<int>(boost::thread::hardware_concurrency())), 1000, 1, BlockAnalyzer::WEIGHTS_FILE_NAME};
+		for(int i = 1; i < argc; i += 2)
+			{
+			const std::string name = argv[i];
+			if(i + 1 >= argc)
+				throw CuTeEx("Missing value of option " + name);
+			const std::string value = argv[i + 1];
+			if(name == "--output")
+				options.output = value;
+			else if(name == "--seed")
+				options.seed = lexical_cast<unsigned int>(value);
+			else
+				{
+				int* target = NULL;
+				if(name == "--size")
+					target = &options.size;
+				else if(name == "--depth")
+					target = &options.depth;
+				else if(name == "--set")
+					target = &options.blocksSet;
+				else if(name == "--games")
+					target = &options.games;
+				else if(name == "--generations")
+					target = &options.generations;
+				else if(name == "--population")
+					target = &options.population;
+				else if(name == "--threads")
+					target = &options.threads;
+				else if(name == "--max-blocks")
+					target = &options.maxBlocks;
+				else
+					throw CuTeEx("Unknown option " + name);
+				*target = (name == "--set")? lexical_cast<int>(value) : std::max(1, lexical_cast<int>(value));
+				}
+			}
+		return options;
+		}
+
+	}
+
+//----------------------------------------------------------------------------
+
+int main(int argc, char* argv[])
+	{
+	try
+		{
+		const Options options = readOptions(argc, argv);
+		MyXML::Key diffData;
+		Difficulty difficulty(diffData);
+		difficulty.size(options.size);
+		difficulty.depth(options.depth);
+		difficulty.blocksSet(options.blocksSet);
+		SelfPlay profile(difficulty, 0);		//only to load and save the weights
+		profile.analyzer().loadWeights(options.output);
+		Candidate parent = {{profile.analyzer().heightsWeight(), profile.analyzer().distsWeight(),
+			profile.analyzer().edgesWeight()}, 0.0, 0.0, 0.0};
+		std::vector<Candidate> candidates(1, parent);
+		double cpuTime = evaluate(candidates, difficulty, options);
+		Candidate best = candidates.front();
+		std::cout << "start  ";
+		print(best);
+		std::cout << std::endl;
+		boost::mt19937 generator(options.seed);
+		boost::variate_generator<boost::mt19937&, boost::normal_distribution<> > normal(generator,
+			boost::normal_distribution<>());
+		double sigma = 0.5;		//relative mutation strength, decreases every generation
+		for(int g = 0; g < options.generations; ++g, sigma *= 0.85)
+			{
+			candidates.assign(options.population, parent);
+			for(std::vector<Candidate>::iterator i = candidates.begin() + 1; i != candidates.end(); ++i)
+				for(int w = 0; w < 3; ++w)
+					{
+					const double scale = std::max(2.0, std::fabs(static_cast<double>(parent.weights[w])));
+					i->weights[w] = static_cast<int>(floor(parent.weights[w] + normal() * sigma * scale + 0.5));
+					}
+			const double time = evaluate(candidates, difficulty, options);
+			cpuTime += time;
+			std::sort(candidates.begin(), candidates.end(), better);
+			const int parents = std::max(1, options.population / 4);
+			for(int w = 0; w < 3; ++w)
+				{		//new parent is the mean of the best candidates
+				double sum = 0.0;
+				for(int i = 0; i < parents; ++i)
+					sum += candidates[i].weights[w];
+				parent.weights[w] = static_cast<int>(floor(sum / parents + 0.5));
+				}
+			if(better(candidates.front(), best))
+				best = candidates.front();
+			double points = 0.0, planes = 0.0, blocks = 0.0;
+			for(std::vector<Candidate>::const_iterator i = candidates.begin(); i != candidates.end(); ++i)
+				{
+				points += i->points;
+				planes += i->planes;
+				blocks += i->blocks;
+				}
+			const double games = options.games / std::max(time, 1e-6);		//games of every candidate per CPU-second
+			std::cout << "gen " << std::setw(2) << g + 1 << " ";
+			print(candidates.front());
+			std::cout << "  per CPU-second: points " << points * games << " planes " << planes * games <<
+				" blocks " << blocks * games << std::endl;
+			}
+		std::cout << "best   ";
+		print(best);
+		std::cout << std::endl << "CPU time " << std::setprecision(2) << cpuTime << " s" << std::endl;
+		profile.analyzer().weights(best.weights[0], best.weights[1], best.weights[2]);
+		profile.analyzer().saveWeights(options.output);
+		}
+	catch(const std::exception& e)
+		{
+		std::cerr << e.what() << std::endl;
+		return 1;
+		}
+	return 0;
+	}
+
+//----------------------------------------------------------------------------
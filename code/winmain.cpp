@@ -45,18 +45,6 @@ using namespace CuTe;
 namespace CuTe
 	{
 
-//----------------------------------------------------------------------------
-
-	///Definition of a langData variable.
-	///This variable is declared in the language.h file. It stores all the messages displayed in the
-	///game allowing to introduce multiple languages to the game.
-	MyXML::Key langData;
-
-	///Definition of a langInfo variable.
-	///This variable is declared in the language.h file. It stores the language additional information
-	///like language pack author, fonts, etc.
-	MyXML::Key langInfo;
-
 //----------------------------------------------------------------------------
 
 	///Game options information key.
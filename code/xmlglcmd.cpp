@@ -1,7 +1,7 @@
 //----------------------------------------------------------------------------
 
 ///@file
-///Definitions of functions from xmlglcmd.h
+///XMLModel class definitions.
 ///
 ///@par License:
 ///@verbatim
@@ -30,88 +30,146 @@
 #include <stdexcept>
 #include <boost/lexical_cast.hpp>
 #include "xmlglcmd.h"
+#include "MyOGL/hsv2rgb.h"
 using namespace CuTe;
-using MyOGL::glColorHSV;
 using boost::lexical_cast;
 
 //----------------------------------------------------------------------------
 
-///Converts OpenGL enumarator string to its numeric value.
-///Converts a string like "QUADS" into GLenum type with a value "GL_QUADS".
-///@param command XML key containing the enumerator as its value.
-///@return GLenum with the numeric value of the given enumerator.
-GLenum toGLenum(const MyXML::Key& command)
+namespace
 	{
-	if(command.value() == "TEXTURE_2D")
-		return GL_TEXTURE_2D;
-	if(command.value() == "LINE_LOOP")
-		return GL_LINE_LOOP;
-	if(command.value() == "LINES")
-		return GL_LINES;
-	if(command.value() == "QUADS")
-		return GL_QUADS;
-	throw std::invalid_argument('\"' + command.value() + "' is not a valid OpenGL enumerator");
-	}
-
-//----------------------------------------------------------------------------
 
-void CuTe::executeGLCommand(const MyXML::Key& command)
-	{
-	const std::string id = command.attribute("id");
-	if(id == "vertex")
-		{
-		glVertex3f(lexical_cast<float>(command["coords"].attribute("x")),
-			lexical_cast<float>(command["coords"].attribute("y")),
-			lexical_cast<float>(command["coords"].attribute("z")));
-		return;
-		}
-	if(id == "texcoords")
-		{
-		glTexCoord2f(lexical_cast<float>(command["coords"].attribute("s")),
-			lexical_cast<float>(command["coords"].attribute("t")));
-		return;
-		}
-	if(id == "hsvcolor")
-		{
-		glColorHSV(lexical_cast<float>(command["hsv"].attribute("h")),
-			lexical_cast<float>(command["hsv"].attribute("s")),
-			lexical_cast<float>(command["hsv"].attribute("v")));
-		return;
-		}
-	if(id == "begin")
-		{
-		glBegin(toGLenum(command));
-		return;
-		}
-	if(id == "end")
+	///Converts OpenGL primitive string to Renderer::Primitive.
+	///Converts a string like "QUADS" into Renderer::QUADS.
+	///@param command XML key containing the primitive as its value.
+	///@return Renderer primitive.
+	Renderer::Primitive toPrimitive(const MyXML::Key& command)
 		{
-		glEnd();
-		return;
+		if(command.value() == "LINE_LOOP")
+			return Renderer::LINE_LOOP;
+		if(command.value() == "LINES")
+			return Renderer::LINES;
+		if(command.value() == "QUADS")
+			return Renderer::QUADS;
+		throw std::invalid_argument('\"' + command.value() + "' is not a valid OpenGL primitive");
 		}
-	if(id == "enable")
+
+	///Checks if the enable or disable command is given textures.
+	///@param command XML key containing the enumerator as its value.
+	///@throw std::invalid_argument If the enumerator isn't TEXTURE_2D.
+	void checkTexture(const MyXML::Key& command)
 		{
-		glEnable(toGLenum(command));
-		return;
+		if(command.value() != "TEXTURE_2D")
+			throw std::invalid_argument('\"' + command.value() + "' is not a valid OpenGL enumerator");
 		}
-	if(id == "disable")
+
+	///Reads a coordinate from a command.
+	///@param command XML key containing the command.
+	///@param key Name of the sub key with the coordinates.
+	///@param name Name of the coordinate attribute.
+	///@return Coordinate value.
+	float coord(const MyXML::Key& command, const char* key, const char* name)
 		{
-		glDisable(toGLenum(command));
-		return;
+		return lexical_cast<float>(command[key].attribute(name));
 		}
-	throw std::invalid_argument('\"' + id + "' is unsupported OpenGL command");
+
 	}
 
 //----------------------------------------------------------------------------
 
-GLuint CuTe::buildDisplayList(const MyXML::Key& commands)
+void XMLModel::build(Renderer& renderer, const MyXML::Key& commands)
 	{
+	Renderer::TexColorVertex current = {0.0, 0.0, {255, 255, 255, 255}, 0.0, 0.0, 0.0};
+	bool colored = false;		//set by the first hsvcolor, vertices have no color before
+	bool textured = false;
+	Renderer::Primitive primitive = Renderer::POINTS;
+	std::vector<Renderer::TexColorVertex> vertices;
 	MyXML::KeysConstRange cmds = commands.keys("cmd");
-	GLuint id = glGenLists(1);
-	glNewList(id, GL_COMPILE);
-	for(MyXML::KeyConstIterator command = cmds.first; command != cmds.second; ++command)
-		executeGLCommand(command->second);
-	glEndList();
-	return id;
+	for(MyXML::KeyConstIterator i = cmds.first; i != cmds.second; ++i)
+		{
+		const MyXML::Key& command = i->second;
+		const std::string id = command.attribute("id");
+		if(id == "vertex")
+			{
+			current.x = coord(command, "coords", "x");
+			current.y = coord(command, "coords", "y");
+			current.z = coord(command, "coords", "z");
+			vertices.push_back(current);
+			continue;
+			}
+		if(id == "texcoords")
+			{
+			current.s = coord(command, "coords", "s");
+			current.t = coord(command, "coords", "t");
+			continue;
+			}
+		if(id == "hsvcolor")
+			{
+			float rgb[3];
+			MyOGL::hsv2rgb(coord(command, "hsv", "h"), coord(command, "hsv", "s"), coord(command, "hsv", "v"), rgb);
+			for(int c = 0; c < 3; ++c)
+				current.color[c] = static_cast<unsigned char>(rgb[c] * 255);
+			colored = true;
+			continue;
+			}
+		if(id == "begin")
+			{
+			primitive = toPrimitive(command);
+			vertices.clear();
+			continue;
+			}
+		if(id == "end")
+			{
+			if(vertices.empty())
+				continue;		//nothing to draw
+			Part part;
+			part.textured = textured;
+			if(colored)
+				part.mesh = renderer.createMesh(primitive, Renderer::T2F_C4UB_V3F, &vertices[0],
+					static_cast<int>(vertices.size()));
+			else
+				{		//drop the colors, the color set before draw() is used
+				std::vector<Renderer::TexVertex> plain(vertices.size());
+				for(std::size_t v = 0; v < vertices.size(); ++v)
+					{
+					plain[v].s = vertices[v].s;
+					plain[v].t = vertices[v].t;
+					plain[v].x = vertices[v].x;
+					plain[v].y = vertices[v].y;
+					plain[v].z = vertices[v].z;
+					}
+				part.mesh = renderer.createMesh(primitive, Renderer::T2F_V3F, &plain[0],
+					static_cast<int>(plain.size()));
+				}
+			parts.push_back(part);
+			continue;
+			}
+		if(id == "enable")
+			{
+			checkTexture(command);
+			textured = true;
+			continue;
+			}
+		if(id == "disable")
+			{
+			checkTexture(command);
+			textured = false;
+			continue;
+			}
+		throw std::invalid_argument('\"' + id + "' is unsupported OpenGL command");
+		}
+	}
+
+void XMLModel::draw(Renderer& renderer) const
+	{
+	for(std::vector<Part>::const_iterator part = parts.begin(); part != parts.end(); ++part)
+		{
+		if(part->textured)
+			renderer.enable(Renderer::TEXTURE);
+		renderer.drawMesh(part->mesh);
+		if(part->textured)
+			renderer.disable(Renderer::TEXTURE);
+		}
 	}
 
 //----------------------------------------------------------------------------
@@ -1,7 +1,7 @@
 //----------------------------------------------------------------------------
 
 ///@file
-///Routines for reading and processing OpenGL commands saved in XML file.
+///XMLModel class declaration, models made of OpenGL commands saved in XML file.
 ///
 ///@par License:
 ///@verbatim
@@ -32,8 +32,9 @@
 
 //----------------------------------------------------------------------------
 
+#include <vector>
 #include "MyXML/myxml.h"
-#include "MyOGL/scene.h"
+#include "render.h"
 
 //----------------------------------------------------------------------------
 
@@ -42,8 +43,11 @@ namespace CuTe
 
 //----------------------------------------------------------------------------
 
-	///Calls OpenGL command coded in XML key.
-	///XML key should have the following pattern:
+	///Model made of OpenGL commands coded in XML keys.
+	///@author Tomasz Nurkiewicz, T.Nurkiewicz@stud.elka.pw.edu.pl
+	///@date Jul 2005-Mar 2006
+	///@par
+	///Every command is a key with the following pattern:
 	///@verbatim
 	/// <cmd id="SSS" />
 	///@endverbatim
@@ -52,24 +56,43 @@ namespace CuTe
 	/// "y" and "z"</td></tr>
 	/// <tr><td>hsvcolor</td><td>Changes the color using HSV color model; key should have a sub key
 	/// "hsv" with attributes "h", "s" and "v"</td></tr>
-	/// <tr><td>begin</td><td>Begin OpenGL drawings; the key's value should be one of the: GL_LINES,
-	/// GL_LINE_LOOP</td></tr>
+	/// <tr><td>begin</td><td>Begin OpenGL drawings; the key's value should be one of the: LINES,
+	/// LINE_LOOP, QUADS</td></tr>
 	/// <tr><td>end</td><td>Finishes the OpenGL drawings</td></tr>
-	/// <tr><td>enable</td><td>calls glEnable(); the key's value should be OpenGL enumerator
-	/// to enable (e.g. TEXTURE_2D)</td></tr>
-	/// <tr><td>disable</td><td>calls glDisable(); the key's value should be OpenGL enumerator
-	/// to disable (e.g. TEXTURE_2D)</td></tr>
-	/// <tr><td>texcoords</td><td>calls glTexCoord2f() with given parameters; the key should have a
-	/// sub key "coords" which has attributes "s" and "t"</td></tr></table>
-	///@param command XML key containing coded OpenGL command.
-	void executeGLCommand(const MyXML::Key& command);
-
-	///Builds the OpenGL display list containing desired set of GL commands.
-	///Creates an OpenGL display list and returns its alias for futher use in glCallList()
-	///@param commands XML key containing coded OpenGL commands how to build display list.
-	///@return OpenGL alias to the display list which can be used in the future by glCallList()
-	///@sa executeGLCommand()
-	GLuint buildDisplayList(const MyXML::Key& commands);
+	/// <tr><td>enable</td><td>Enables textures; the key's value should be TEXTURE_2D</td></tr>
+	/// <tr><td>disable</td><td>Disables textures; the key's value should be TEXTURE_2D</td></tr>
+	/// <tr><td>texcoords</td><td>Sets the texture coordinates of the next vertices; the key should
+	/// have a sub key "coords" which has attributes "s" and "t"</td></tr></table>
+	///@par
+	///Every begin/end part is kept as a single renderer mesh. Until the first hsvcolor the vertices
+	///have no color, so the model is drawn with the color set before draw().
+	class XMLModel
+		{
+		private:
+			///Single begin/end part of the model.
+			struct Part
+				{
+				///Mesh with the part vertices.
+				int mesh;
+				///True if the textures were enabled in the part.
+				bool textured;
+				};
+			///All the parts in the order they were coded.
+			std::vector<Part> parts;
+		public:
+			///Builds the model meshes.
+			///Meshes are never released, like the display lists this class replaces: the models live
+			///as long as the window.
+			///@param renderer Renderer which keeps the meshes.
+			///@param commands XML key containing coded OpenGL commands.
+			///@throw std::invalid_argument If an unsupported command or value is found.
+			void build(Renderer& renderer, const MyXML::Key& commands);
+			///Tells whether the model was built.
+			bool empty() const	{return parts.empty();}
+			///Draws the model.
+			///@param renderer Renderer which built the model (or another one sharing its meshes).
+			void draw(Renderer& renderer) const;
+		};		//class XMLModel
 
 //----------------------------------------------------------------------------
 